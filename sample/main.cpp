@@ -1,18 +1,19 @@
 #include <algorithm>
 #include <array>
 #include <bit>
+#include <cassert>
 #include <climits>
 #include <concepts>
 #include <cstddef>
 #include <cstdint>
-#include <format>
 #include <iostream>
 #include <optional>
 #include <span>
+#include <string_view>
 
 #include "unformatter/bit_unformatter.hpp"
+#include "unformatter/encoding.hpp"
 #include "unformatter/unformatter.hpp"
-#include "unformatter/util.hpp"
 
 namespace
 {
@@ -25,7 +26,7 @@ public:
     template<typename... GroupArgs>
     requires(sizeof...(GroupArgs) == OCTETS / sizeof(Group) &&
              (std::convertible_to<GroupArgs, Group> && ...))
-    explicit IPv6Addres(const GroupArgs... groups)
+    explicit constexpr IPv6Addres(const GroupArgs... groups)
     {
         const auto buf = std::to_array({static_cast<Group>(groups)...});
         const auto bufUnfmt = unformatter::UnformatterDynamic<const Group>(buf);
@@ -37,7 +38,7 @@ public:
     }
 
     [[nodiscard]]
-    std::span<const std::byte, OCTETS> data() const
+    constexpr std::span<const std::byte, OCTETS> data() const
     {
         return data_;
     }
@@ -46,7 +47,7 @@ private:
     std::array<std::byte, OCTETS> data_{};
 };
 
-std::optional<std::span<std::byte>> prepareIPv6Packet(
+constexpr std::optional<std::span<std::byte>> prepareIPv6Packet(
     std::span<std::byte> buf, const IPv6Addres &src, const IPv6Addres &dst,
     std::span<const std::byte> data)
 {
@@ -69,12 +70,11 @@ std::optional<std::span<std::byte>> prepareIPv6Packet(
     const auto [fieldUnfmt, addressUnfmt] = headerUnfmt.split<8>();
     const auto [prefixUnfmt, controlUnfmt] = fieldUnfmt.split<4>();
     {
-        const auto prefixBitUnfmt = unformatter::createBit(prefixUnfmt);
-        const auto [versionUnfmt, trafficUnfmt, flowUnfmt] =
-            unformatter::util::split<4, 12>(prefixBitUnfmt);
-        versionUnfmt.writeRepr(6);
-        trafficUnfmt.writeRepr(0);
-        flowUnfmt.writeRepr(0xdead);
+        // Version, traffic class and flow label.
+        [[maybe_unused]] const auto res =
+            unformatter::createBit(prefixUnfmt).writeFields<4, 8, 20>(
+                6, 0, 0xdead);
+        assert(res);
     }
     const auto payloadLengthUnfmt = controlUnfmt.subs<0, 2>();
     payloadLengthUnfmt.write<std::endian::big, std::uint16_t>(data.size());
@@ -95,10 +95,10 @@ std::optional<std::span<std::byte>> prepareIPv6Packet(
 
 void testUnformatter()
 {
-    const IPv6Addres src(0x8023, 0x3333, 0x7777, 0x6655, 0x1234, 0x8888, 0x9999,
-                         0xabcd);
-    const IPv6Addres dst(0x90ef, 0x5555, 0x3333, 0x6789, 0xfedc, 0x2222, 0x2345,
-                         0xdcba);
+    constexpr IPv6Addres src(0x8023, 0x3333, 0x7777, 0x6655, 0x1234, 0x8888,
+                             0x9999, 0xabcd);
+    constexpr IPv6Addres dst(0x90ef, 0x5555, 0x3333, 0x6789, 0xfedc, 0x2222,
+                             0x2345, 0xdcba);
     constexpr std::size_t DATA_SIZE = 16;
     constexpr std::size_t HEADER_SIZE = 40;
     std::array<std::byte, HEADER_SIZE + DATA_SIZE> buf{};
@@ -111,11 +111,16 @@ void testUnformatter()
         std::cerr << "packet prepare failed" << '\n';
         return;
     }
-    for(const auto val : *res)
+    std::array<char, unformatter::hexEncodedSize(buf.size())> hex{};
+    const auto hexUnfmt = unformatter::UnformatterDynamic<char>(
+        std::span(hex).first(unformatter::hexEncodedSize(res->size())));
+    if(!unformatter::hexEncode(unformatter::UnformatterDynamic<std::byte>(*res),
+                               hexUnfmt))
     {
-        std::cerr << std::format("{:02x}", static_cast<unsigned char>(val));
+        std::cerr << "packet encode failed" << '\n';
+        return;
     }
-    std::cerr << '\n';
+    std::cerr << std::string_view(hexUnfmt) << '\n';
 }
 
 void runUnformatter()
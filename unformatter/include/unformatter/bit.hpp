@@ -3,6 +3,7 @@
 
 #include <concepts>
 #include <cstddef>
+#include <ranges>
 #include <span>
 #include <type_traits>
 
@@ -18,26 +19,61 @@ struct Bit : inner::BaseBit
 {
     using Byte = std::byte;
 
-    template<typename T>
+    template<typename T, std::size_t Extent>
     requires(!std::is_const_v<T>)
-    static constexpr std::span<Byte> asBytes(std::span<T> data)
+    static constexpr std::span<Byte> asBytes(std::span<T, Extent> data)
     {
-        return std::as_writable_bytes(data);
+        if constexpr(std::same_as<T, std::byte>)
+        {
+            return data;
+        }
+        else
+        {
+            return std::as_writable_bytes(data);
+        }
     }
 };
 struct ConstBit : inner::BaseBit
 {
     using Byte = const std::byte;
 
-    template<typename T>
-    static constexpr std::span<Byte> asBytes(std::span<T> data)
+    template<typename T, std::size_t Extent>
+    static constexpr std::span<Byte> asBytes(std::span<T, Extent> data)
     {
-        return std::as_bytes(data);
+        if constexpr(std::same_as<std::remove_const_t<T>, std::byte>)
+        {
+            return data;
+        }
+        else
+        {
+            return std::as_bytes(data);
+        }
     }
 };
 
 namespace inner
 {
+    template<typename V>
+    concept ByteArray =
+        std::ranges::contiguous_range<V> && std::ranges::sized_range<V> &&
+        std::same_as<std::remove_cv_t<std::ranges::range_value_t<V>>,
+                     std::byte>;
+
+    // Byte arrays are viewed directly, so bit access to them stays usable in
+    // constant evaluation.
+    template<typename V>
+    constexpr auto objectSpan(V &val)
+    {
+        if constexpr(ByteArray<V>)
+        {
+            return std::span(val);
+        }
+        else
+        {
+            return std::span(&val, 1);
+        }
+    }
+
     template<typename T, typename = void>
     struct ToBit;
     template<typename T>
@@ -2,19 +2,27 @@
 #define UNFORMATTER_BITUNFORMATTER_HPP
 
 #include <algorithm>
+#include <array>
 #include <bit>
+#include <cassert>
 #include <climits>
 #include <concepts>
 #include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
 #include <optional>
 #include <ranges>
 #include <span>
 #include <type_traits>
+#include <utility>
 
 #include "unformatter/bit.hpp"
+#include "unformatter/check.hpp"
 #include "unformatter/inner/bitutil.hpp"
 #include "unformatter/inner/common.hpp"
 #include "unformatter/size.hpp"
+#include "unformatter/stats.hpp"
 #include "unformatter/unformatter.hpp"
 
 namespace unformatter
@@ -22,273 +30,584 @@ namespace unformatter
 template<BitType B, SizeType S>
 class BitUnformatter;
 
-template<BitType B>
-class BitUnformatter<B, DynamicSize>
+namespace inner
 {
-    using MaxIntegralType = unsigned long long int;
-
-    template<typename Bt>
-    struct BitSpan
+    // Common part of all bit unformatters. Ranges of a single size keep the
+    // size in BitExtent and store only the pointer and the bit offset.
+    template<BitType B, std::size_t BitExtent>
+    class BitUnformatterBase
     {
-        std::span<Bt> data;
-        std::size_t bitOffset;
-    };
+        template<BitType, std::size_t>
+        friend class BitUnformatterBase;
 
-    template<typename ST>
-    struct DataSpan
-    {
-        ST data;
-        std::size_t bitOffset;
-    };
+        template<BitType, SizeType>
+        friend class unformatter::BitUnformatter;
 
-public:
-    template<typename V>
-    requires std::is_trivial_v<V>
-    explicit constexpr BitUnformatter(V &val)
-        : BitUnformatter(inner::ToBit<V>::Type::asBytes(std::span(&val, 1)))
-    {
-    }
+        using Byte = typename B::Byte;
+        using MaxIntegralType = unsigned long long int;
 
-    template<typename V>
-    explicit constexpr BitUnformatter(const Unformatter<V, DynamicSize> &other)
-        : BitUnformatter(inner::ToBit<V>::Type::asBytes(other.data_))
-    {
-    }
+        struct NoSize
+        {
+        };
+        using SizeStorage =
+            std::conditional_t<BitExtent == std::dynamic_extent, std::size_t,
+                               NoSize>;
 
-    [[nodiscard]]
-    constexpr std::size_t size() const
-    {
-        return bitSize;
-    }
+    public:
+        [[nodiscard]]
+        constexpr std::size_t size() const
+        {
+            if constexpr(BitExtent == std::dynamic_extent)
+            {
+                return bitSize_;
+            }
+            else
+            {
+                return BitExtent;
+            }
+        }
 
-    [[nodiscard]]
-    constexpr std::optional<BitUnformatter> subs(
-        std::size_t offset, std::optional<std::size_t> maybeSize = {}) const
-    {
-        if(const auto maybeSubsSize =
-               inner::common::subsSize(offset, maybeSize, size()))
+        [[nodiscard]]
+        constexpr std::optional<BitUnformatter<B, DynamicSize>> subs(
+            const std::size_t offset,
+            const std::optional<std::size_t> maybeSize = {}) const
         {
-            auto resultData = data_;
-            if(resultData.bitOffset != 0)
+            if(const auto maybeSubsSize =
+                   inner::common::subsSize(offset, maybeSize, size()))
             {
-                const auto leftOffset =
-                    inner::bitutil::BYTE_BIT - resultData.bitOffset;
-                if(offset >= leftOffset)
-                {
-                    resultData.data = resultData.data.subspan(1);
-                    resultData.bitOffset = 0;
-                    offset -= leftOffset;
-                }
-                else
-                {
-                    resultData.bitOffset += offset;
-                    offset = 0;
-                }
+                return BitUnformatter<B, DynamicSize>(advance(offset),
+                                                      *maybeSubsSize);
             }
-            resultData = advanceBit(resultData, offset);
-            return BitUnformatter(resultData, *maybeSubsSize);
+            stats::Policy::boundsFailure(stats::Site::bitSubs);
+            return std::nullopt;
         }
-        return std::nullopt;
-    }
 
-    template<typename V>
-    requires std::is_trivial_v<V>
-    [[nodiscard]]
-    constexpr bool write(const V &val)
-    {
-        const BitUnformatter that(val);
-        return writeCollection(that);
-    }
+        // Like subs without the result wrapping, see
+        // UnformatterBase::subsUnchecked.
+        template<CheckPolicy Check = DebugChecked>
+        [[nodiscard]]
+        constexpr BitUnformatter<B, DynamicSize> subsUnchecked(
+            const std::size_t offset,
+            const std::size_t bitSize = std::dynamic_extent) const
+        {
+            Check::check(offset <= size() &&
+                         (bitSize == std::dynamic_extent ||
+                          bitSize <= size() - offset));
+            return BitUnformatter<B, DynamicSize>(
+                advance(offset),
+                bitSize == std::dynamic_extent ? size() - offset : bitSize);
+        }
 
-    template<typename V>
-    requires std::is_trivial_v<V>
-    [[nodiscard]]
-    constexpr bool read(V &val)
-    {
-        const BitUnformatter that(val);
-        return readCollection(that);
-    }
+        template<typename V>
+        requires std::is_trivial_v<V>
+        [[nodiscard]]
+        constexpr bool write(const V &val) const
+        {
+            const BitUnformatter<ConstBit, DynamicSize> that(val);
+            return writeCollection(that);
+        }
 
-    template<BitType BitArg>
-    [[nodiscard]]
-    constexpr bool writeCollection(
-        const BitUnformatter<BitArg, DynamicSize> &other) const
-    {
-        if(size() != other.size())
+        template<typename V>
+        requires std::is_trivial_v<V>
+        [[nodiscard]]
+        constexpr bool read(V &val) const
         {
-            return false;
+            const BitUnformatter<Bit, DynamicSize> that(val);
+            return readCollection(that);
         }
-        copyBits(data_, other.data_, bitSize);
-        return true;
-    }
 
-    template<BitType BitArg>
-    [[nodiscard]]
-    constexpr bool readCollection(
-        const BitUnformatter<BitArg, DynamicSize> &other) const
-    {
-        if(size() != other.size())
+        template<BitType BitArg, std::size_t OtherBitExtent>
+        [[nodiscard]]
+        constexpr bool writeCollection(
+            const BitUnformatterBase<BitArg, OtherBitExtent> &other) const
         {
-            return false;
+            if(size() != other.size())
+            {
+                stats::Policy::boundsFailure(stats::Site::bitWriteCollection);
+                return false;
+            }
+            copyBits(data_, bitOffset_, other.data_, other.bitOffset_, size());
+            return true;
         }
-        copyBits(other.data_, data_, bitSize);
-        return true;
-    }
 
-    template<std::integral V>
-    bool writeRepr(V val) const
-    {
-        constexpr auto bytesRoundUp = [](const std::size_t bits) {
-            return (bits + inner::bitutil::BYTE_BIT - 1) /
-                   inner::bitutil::BYTE_BIT;
-        };
-        if(!isRepresentable(val, bitSize))
+        template<BitType BitArg, std::size_t OtherBitExtent>
+        [[nodiscard]]
+        constexpr bool readCollection(
+            const BitUnformatterBase<BitArg, OtherBitExtent> &other) const
         {
-            return false;
+            if(size() != other.size())
+            {
+                stats::Policy::boundsFailure(stats::Site::bitReadCollection);
+                return false;
+            }
+            copyBits(other.data_, other.bitOffset_, data_, bitOffset_, size());
+            return true;
+        }
+
+        template<std::integral V>
+        constexpr bool writeRepr(V val) const
+        {
+            if(!isRepresentable(val, size()))
+            {
+                stats::Policy::boundsFailure(stats::Site::bitWriteRepr);
+                return false;
+            }
+            storeRepr(val, size());
+            return true;
         }
-        const MaxIntegralType cur = val;
-        const auto curBitSize = std::min(
-            sizeof(MaxIntegralType) * inner::bitutil::BYTE_BIT, bitSize);
-        const auto byteSize = bytesRoundUp(curBitSize);
-        const auto src = [&] {
-            const auto bytes = std::as_bytes(std::span(&cur, 1));
-            if constexpr(inner::common::isNativeEndianness<
-                             std::endian::little>())
+
+        // Passes the bits to visit as words of up to 64 bits, most
+        // significant bit first, with the bit count of each word. The last
+        // word holds the remaining bits in its lowest bits.
+        template<typename Visit>
+        constexpr void visitWords(Visit &&visit) const
+        {
+            for(std::size_t offset = 0; offset < size();
+                offset += inner::bitutil::WORD_BITS)
             {
-                return bytes.subspan(0, byteSize) | std::views::reverse;
+                const auto bits =
+                    std::min(size() - offset, inner::bitutil::WORD_BITS);
+                visit(loadWord(offset, bits), bits);
+            }
+        }
+
+        // Combine the bits with the bits of another range of the same size
+        // in place, the ranges may have any bit offsets.
+        template<BitType BitArg, std::size_t OtherBitExtent>
+        requires std::same_as<B, Bit>
+        [[nodiscard]]
+        constexpr bool andWith(
+            const BitUnformatterBase<BitArg, OtherBitExtent> &other) const
+        {
+            return apply(other, std::bit_and<>{});
+        }
+
+        template<BitType BitArg, std::size_t OtherBitExtent>
+        requires std::same_as<B, Bit>
+        [[nodiscard]]
+        constexpr bool orWith(
+            const BitUnformatterBase<BitArg, OtherBitExtent> &other) const
+        {
+            return apply(other, std::bit_or<>{});
+        }
+
+        template<BitType BitArg, std::size_t OtherBitExtent>
+        requires std::same_as<B, Bit>
+        [[nodiscard]]
+        constexpr bool xorWith(
+            const BitUnformatterBase<BitArg, OtherBitExtent> &other) const
+        {
+            return apply(other, std::bit_xor<>{});
+        }
+
+        constexpr void invert() const
+        requires std::same_as<B, Bit>
+        {
+            inner::bitutil::applyBits(
+                coveredBytes(), bitOffset_, coveredBytes(), bitOffset_, size(),
+                inner::bitutil::inner::InvertSource{});
+        }
+
+        [[nodiscard]]
+        constexpr std::size_t countOnes() const
+        {
+            return inner::bitutil::countOnes(coveredBytes(), bitOffset_,
+                                             size());
+        }
+
+        // Position of the first set bit at or after from, most significant
+        // bit first like the other accesses.
+        [[nodiscard]]
+        constexpr std::optional<std::size_t> findFirstSet(
+            const std::size_t from = 0) const
+        {
+            return findFirst<true>(from);
+        }
+
+        [[nodiscard]]
+        constexpr std::optional<std::size_t> findFirstClear(
+            const std::size_t from = 0) const
+        {
+            return findFirst<false>(from);
+        }
+
+        [[nodiscard]]
+        constexpr std::size_t countLeadingZeros() const
+        {
+            return findFirstSet().value_or(size());
+        }
+
+        // Position of the first match of the lowest patternBits bits of the
+        // pattern at or after from, most significant bit first. The match
+        // may start at any bit, like a sync word in a serial capture.
+        [[nodiscard]]
+        constexpr std::optional<std::size_t> findPattern(
+            const std::uint64_t pattern, const std::size_t patternBits,
+            const std::size_t from = 0) const
+        {
+            if(from >= size())
+            {
+                return std::nullopt;
+            }
+            const auto found = inner::bitutil::findPattern(
+                coveredBytes(), bitOffset_ + from, size() - from, pattern,
+                patternBits);
+            return found ? std::optional(from + *found) : std::nullopt;
+        }
+
+        // Bit contents are compared, positions in the bytes may differ.
+        template<BitType BitArg, std::size_t OtherBitExtent>
+        [[nodiscard]]
+        constexpr bool operator==(
+            const BitUnformatterBase<BitArg, OtherBitExtent> &other) const
+        {
+            if(size() != other.size())
+            {
+                return false;
+            }
+            std::uint64_t diff = 0;
+            for(std::size_t offset = 0; offset < size();
+                offset += inner::bitutil::WORD_BITS)
+            {
+                const auto bits =
+                    std::min(size() - offset, inner::bitutil::WORD_BITS);
+                diff |= loadWord(offset, bits) ^ other.loadWord(offset, bits);
+            }
+            return diff == 0;
+        }
+
+    protected:
+        constexpr BitUnformatterBase(Byte *data, const std::size_t bitOffset,
+                                     [[maybe_unused]] const std::size_t bitSize)
+            : data_(data), bitOffset_(bitOffset)
+        {
+            if constexpr(BitExtent == std::dynamic_extent)
+            {
+                bitSize_ = bitSize;
             }
             else
             {
-                return bytes.subspan(bytes.size() - byteSize);
+                assert(bitSize == BitExtent);
             }
-        }();
-        auto curSpan = data_;
-        if(const auto extraZeroBits = bitSize - curBitSize)
-        {
-            copyBits(curSpan,
-                     DataSpan{std::views::iota(bytesRoundUp(extraZeroBits)) |
-                                  std::views::transform(
-                                      [](const auto) { return std::byte{0}; }),
-                              0},
-                     extraZeroBits);
-            curSpan = advanceBit(curSpan, extraZeroBits);
-        }
-        copyBits(curSpan,
-                 DataSpan{src, (inner::bitutil::BYTE_BIT -
-                                curBitSize % inner::bitutil::BYTE_BIT) %
-                                   inner::bitutil::BYTE_BIT},
-                 curBitSize);
-        return true;
-    }
+        }
 
-protected:
-    template<std::integral V>
-    static constexpr bool isRepresentable(const V value, const std::size_t bits)
-    {
-        auto limit = ~(static_cast<MaxIntegralType>(0));
-        const auto limitSize = sizeof(limit) * inner::bitutil::BYTE_BIT;
-        if(bits > limitSize)
+        template<std::integral V>
+        static constexpr bool isRepresentable(const V value,
+                                              const std::size_t bits)
         {
-            return true;
+            auto limit = ~(static_cast<MaxIntegralType>(0));
+            const auto limitSize = sizeof(limit) * inner::bitutil::BYTE_BIT;
+            if(bits > limitSize)
+            {
+                return true;
+            }
+            limit >>= (limitSize - bits);
+            return value >= 0 && static_cast<MaxIntegralType>(value) <= limit;
         }
-        limit >>= (limitSize - bits);
-        return value >= 0 && static_cast<MaxIntegralType>(value) <= limit;
-    }
 
-private:
-    explicit constexpr BitUnformatter(std::span<typename B::Byte> data)
-        : BitUnformatter(BitSpan{data, 0},
-                         data.size() * inner::bitutil::BYTE_BIT)
-    {
-    }
+        // Pointer and bit offset of the bit at offset, with the bit offset
+        // kept below a byte.
+        constexpr std::pair<Byte *, std::size_t> advance(
+            const std::size_t offset) const
+        {
+            const auto total = bitOffset_ + offset;
+            return {data_ + total / inner::bitutil::BYTE_BIT,
+                    total % inner::bitutil::BYTE_BIT};
+        }
 
-    constexpr BitUnformatter(BitSpan<typename B::Byte> data,
-                             std::size_t bitSize)
-        : data_(data), bitSize(bitSize)
-    {
-    }
+        // Leading bits past the widest integral are zero filled. MaxBits bounds
+        // the size for static ranges, so small fields get no loops.
+        template<std::size_t MaxBits = std::numeric_limits<std::size_t>::max()>
+        constexpr void storeRepr(const MaxIntegralType value,
+                                 const std::size_t bits) const
+        {
+            constexpr auto WORD_MAX_BITS =
+                std::min(MaxBits, inner::bitutil::WORD_BITS);
+            stats::Policy::bitsCopied(bits, bitOffset_ != 0);
+            const std::span<std::byte> data(
+                data_, (bitOffset_ + bits + inner::bitutil::BYTE_BIT - 1) /
+                           inner::bitutil::BYTE_BIT);
+            auto offset = bitOffset_;
+            if constexpr(MaxBits > inner::bitutil::WORD_BITS)
+            {
+                for(auto zeroBits =
+                        bits - std::min(bits, inner::bitutil::WORD_BITS);
+                    zeroBits > 0;)
+                {
+                    const auto cur =
+                        std::min(zeroBits, inner::bitutil::WORD_BITS);
+                    inner::bitutil::storeBits(data, offset, cur, 0);
+                    offset += cur;
+                    zeroBits -= cur;
+                }
+            }
+            inner::bitutil::storeBits<WORD_MAX_BITS>(
+                data, offset, std::min(bits, inner::bitutil::WORD_BITS),
+                value);
+        }
 
-    template<typename Dst, typename Src>
-    static constexpr void copyBits(const Dst &dst, const Src &src,
-                                   std::size_t bitSize)
-    {
-        if(dst.bitOffset == 0 && src.bitOffset == 0)
+        // Ranges of static size that fit in a word with any bit offset are
+        // stored and loaded with one access to the covering bytes.
+        template<std::size_t Bits>
+        constexpr void storeStaticBits(const std::uint64_t value) const
         {
-            std::ranges::copy(src.data, std::ranges::begin(dst.data));
+            if constexpr(Bits + inner::bitutil::BYTE_BIT - 1 <=
+                         inner::bitutil::WORD_BITS)
+            {
+                stats::Policy::bitsCopied(Bits, bitOffset_ != 0);
+                inner::bitutil::storeWordBits<Bits>(
+                    std::span<std::byte>(data_, coveringBytes(Bits)),
+                    bitOffset_, value);
+            }
+            else
+            {
+                storeRepr<Bits>(value, Bits);
+            }
         }
-        else
+
+        template<std::size_t Bits>
+        constexpr std::uint64_t loadStaticBits() const
         {
-            auto srcIter = std::ranges::begin(src.data);
-            auto dstIter = std::ranges::begin(dst.data);
-            auto leftSize = bitSize;
-            for(; leftSize > 0;
-                leftSize -= std::min(leftSize, inner::bitutil::BYTE_BIT),
-                ++srcIter, ++dstIter)
+            if constexpr(Bits + inner::bitutil::BYTE_BIT - 1 <=
+                         inner::bitutil::WORD_BITS)
+            {
+                return inner::bitutil::loadWordBits<Bits>(
+                    std::span<const std::byte>(data_, coveringBytes(Bits)),
+                    bitOffset_);
+            }
+            else
             {
-                const auto srcValChunk =
-                    inner::bitutil::BYTE_BIT - src.bitOffset;
-                const auto val = inner::bitutil::combineBits(
-                    *srcIter << src.bitOffset, srcValChunk,
-                    (leftSize > srcValChunk && src.bitOffset != 0
-                         ? (*(srcIter + 1) >> srcValChunk)
-                         : std::byte{0}));
-                *(dstIter) = inner::bitutil::combineBits(
-                    *(dstIter), dst.bitOffset, val >> dst.bitOffset,
-                    std::min(dst.bitOffset + leftSize,
-                             inner::bitutil::BYTE_BIT),
-                    *(dstIter));
-                const auto dstValChunk =
-                    inner::bitutil::BYTE_BIT - dst.bitOffset;
-                if(leftSize > dstValChunk && dst.bitOffset != 0)
+                return loadWord<Bits>(0, Bits);
+            }
+        }
+
+        constexpr std::size_t coveringBytes(const std::size_t bits) const
+        {
+            return (bitOffset_ + bits + inner::bitutil::BYTE_BIT - 1) /
+                   inner::bitutil::BYTE_BIT;
+        }
+
+        constexpr std::span<Byte> coveredBytes() const
+        {
+            return std::span<Byte>(data_, coveringBytes(size()));
+        }
+
+        template<BitType BitArg, std::size_t OtherBitExtent, typename Op>
+        constexpr bool apply(
+            const BitUnformatterBase<BitArg, OtherBitExtent> &other,
+            const Op op) const
+        {
+            if(size() != other.size())
+            {
+                stats::Policy::boundsFailure(stats::Site::bitWriteCollection);
+                return false;
+            }
+            inner::bitutil::applyBits(coveredBytes(), bitOffset_,
+                                      other.coveredBytes(), other.bitOffset_,
+                                      size(), op);
+            return true;
+        }
+
+        template<bool Value>
+        constexpr std::optional<std::size_t> findFirst(
+            const std::size_t from) const
+        {
+            if(from >= size())
+            {
+                return std::nullopt;
+            }
+            const auto found = inner::bitutil::findFirst<Value>(
+                coveredBytes(), bitOffset_ + from, size() - from);
+            return found ? std::optional(from + *found) : std::nullopt;
+        }
+
+        // Bits at offset in the lowest bits of the result, MaxBits bounds
+        // the size like in storeRepr.
+        template<std::size_t MaxBits = inner::bitutil::WORD_BITS>
+        constexpr std::uint64_t loadWord(const std::size_t offset,
+                                         const std::size_t bits) const
+        {
+            const auto [data, bitOffset] = advance(offset);
+            return inner::bitutil::loadBits<MaxBits>(
+                std::span<const std::byte>(
+                    data, (bitOffset + bits + inner::bitutil::BYTE_BIT - 1) /
+                              inner::bitutil::BYTE_BIT),
+                bitOffset, bits);
+        }
+
+    private:
+        template<typename Dst, typename Src>
+        static constexpr void copyBits(Dst *dst, const std::size_t dstOffset,
+                                       const Src *src,
+                                       const std::size_t srcOffset,
+                                       const std::size_t bitSize)
+        {
+            const bool unaligned = dstOffset != 0 || srcOffset != 0;
+            stats::Policy::bitsCopied(bitSize, unaligned);
+            if(!unaligned)
+            {
+                const auto fullBytes = bitSize / inner::bitutil::BYTE_BIT;
+                std::copy_n(src, fullBytes, dst);
+                if(const auto tailBits = bitSize % inner::bitutil::BYTE_BIT)
+                {
+                    dst[fullBytes] = inner::bitutil::combineBits(
+                        src[fullBytes], tailBits, dst[fullBytes]);
+                }
+            }
+            else
+            {
+                auto srcIter = src;
+                auto dstIter = dst;
+                auto leftSize = bitSize;
+                for(; leftSize > 0;
+                    leftSize -= std::min(leftSize, inner::bitutil::BYTE_BIT),
+                    ++srcIter, ++dstIter)
                 {
-                    *(dstIter + 1) = inner::bitutil::combineBits(
-                        val << dstValChunk,
-                        std::min(leftSize - dstValChunk,
+                    const auto srcValChunk =
+                        inner::bitutil::BYTE_BIT - srcOffset;
+                    const auto val = inner::bitutil::combineBits(
+                        *srcIter << srcOffset, srcValChunk,
+                        (leftSize > srcValChunk && srcOffset != 0
+                             ? (*(srcIter + 1) >> srcValChunk)
+                             : std::byte{0}));
+                    *(dstIter) = inner::bitutil::combineBits(
+                        *(dstIter), dstOffset, val >> dstOffset,
+                        std::min(dstOffset + leftSize,
                                  inner::bitutil::BYTE_BIT),
-                        *(dstIter + 1));
+                        *(dstIter));
+                    const auto dstValChunk =
+                        inner::bitutil::BYTE_BIT - dstOffset;
+                    if(leftSize > dstValChunk && dstOffset != 0)
+                    {
+                        *(dstIter + 1) = inner::bitutil::combineBits(
+                            val << dstValChunk,
+                            std::min(leftSize - dstValChunk,
+                                     inner::bitutil::BYTE_BIT),
+                            *(dstIter + 1));
+                    }
                 }
             }
         }
+
+        Byte *data_;
+        std::size_t bitOffset_;
+        [[no_unique_address]]
+        SizeStorage bitSize_{};
+    };
+}
+
+template<BitType B>
+class BitUnformatter<B, DynamicSize>
+    : public inner::BitUnformatterBase<B, std::dynamic_extent>
+{
+    template<BitType, std::size_t>
+    friend class inner::BitUnformatterBase;
+
+    using Base = inner::BitUnformatterBase<B, std::dynamic_extent>;
+
+public:
+    template<typename V>
+    requires std::is_trivial_v<V>
+    explicit constexpr BitUnformatter(V &val)
+        : BitUnformatter(inner::ToBit<V>::Type::asBytes(inner::objectSpan(val)))
+    {
+    }
+
+    template<typename V, std::size_t Extent>
+    explicit constexpr BitUnformatter(
+        const inner::UnformatterBase<V, Extent> &other)
+        : BitUnformatter(inner::ToBit<V>::Type::asBytes(other.data_))
+    {
     }
 
-    template<typename Bt>
-    static constexpr BitSpan<Bt> advanceBit(const BitSpan<Bt> &span,
-                                            const std::size_t offset)
+    template<std::size_t BitExtent>
+    constexpr BitUnformatter(
+        const inner::BitUnformatterBase<B, BitExtent> &other)
+        : Base(other.data_, other.bitOffset_, other.size())
     {
-        return {span.data.subspan(offset / inner::bitutil::BYTE_BIT),
-                span.bitOffset + offset % inner::bitutil::BYTE_BIT};
     }
 
-public:
-    BitSpan<typename B::Byte> data_;
-    std::size_t bitSize;
+private:
+    template<std::size_t Extent>
+    explicit constexpr BitUnformatter(std::span<typename B::Byte, Extent> data)
+        : Base(data.data(), 0, data.size() * inner::bitutil::BYTE_BIT)
+    {
+    }
+
+    constexpr BitUnformatter(
+        const std::pair<typename B::Byte *, std::size_t> &position,
+        const std::size_t bitSize)
+        : Base(position.first, position.second, bitSize)
+    {
+    }
 };
 
+namespace inner
+{
+    // Bit sizes of an element range, a static range stays static.
+    template<typename V, std::size_t RngStart, std::size_t RngSize>
+    using BitRangeSize =
+        RangeSize<bufferSize<V, RngStart>() * bitutil::BYTE_BIT,
+                  (RngSize - 1) * bufferSize<V, 1>() * bitutil::BYTE_BIT + 1>;
+
+    // Non empty fields that exactly cover a range of up to a word.
+    template<std::size_t Bits, std::size_t... Widths>
+    consteval bool isFieldGroup()
+    {
+        return Bits <= inner::bitutil::WORD_BITS &&
+               (std::size_t{0} + ... + Widths) == Bits && ((Widths > 0) && ...);
+    }
+
+    // Shift of every field from the lowest bit, the first field is the most
+    // significant.
+    template<std::size_t... Widths>
+    consteval std::array<std::size_t, sizeof...(Widths)> fieldShifts()
+    {
+        std::array<std::size_t, sizeof...(Widths)> shifts{Widths...};
+        std::size_t shift = 0;
+        for(auto idx = shifts.size(); idx > 0; --idx)
+        {
+            const auto width = shifts[idx - 1];
+            shifts[idx - 1] = shift;
+            shift += width;
+        }
+        return shifts;
+    }
+}
+
 template<BitType B, std::size_t RngStart, std::size_t RngSize>
 class BitUnformatter<B, RangeSize<RngStart, RngSize>>
-    : public BitUnformatter<B, DynamicSize>
+    : public inner::BitUnformatterBase<
+          B, inner::rangeExtent<RngStart, RngSize>()>
 {
     template<BitType, SizeType>
     friend class BitUnformatter;
 
+    using Base =
+        inner::BitUnformatterBase<B, inner::rangeExtent<RngStart, RngSize>()>;
+
 public:
     template<typename V>
     requires std::is_trivial_v<V> &&
              (RngSize == 1 && sizeof(V) * inner::bitutil::BYTE_BIT == RngStart)
     explicit constexpr BitUnformatter(V &val)
-        : BitUnformatter<B, DynamicSize>(val)
+        : BitUnformatter(BitUnformatter<B, DynamicSize>(val))
     {
     }
-    template<std::size_t OtherRngStart, std::size_t OtherRngSize, typename V>
-    requires(OtherRngStart *inner::bitutil::BYTE_BIT == RngStart &&
-             OtherRngSize * inner::bitutil::BYTE_BIT == RngSize)
+    template<std::size_t OtherRngStart, std::size_t OtherRngSize,
+             std::size_t OtherRngAlignment, typename V>
+    requires(std::is_same_v<
+             BitUnformatter,
+             BitUnformatter<B, inner::BitRangeSize<V, OtherRngStart,
+                                                   OtherRngSize>>>)
     explicit constexpr BitUnformatter(
-        const Unformatter<V, RangeSize<OtherRngStart, OtherRngSize>> &other)
-        : BitUnformatter<B, DynamicSize>(other)
+        const Unformatter<V, RangeSize<OtherRngStart, OtherRngSize,
+                                       OtherRngAlignment>> &other)
+        : BitUnformatter(BitUnformatter<B, DynamicSize>(other))
     {
     }
 
-    using BitUnformatter<B, DynamicSize>::subs;
+    using Base::subs;
     template<std::size_t Offset,
              inner::common::LiteralOptional<std::size_t> SubsSize =
                  inner::common::LiteralOptional<std::size_t>{}>
@@ -299,62 +618,171 @@ public:
         if constexpr(SubsSize.null)
         {
             return BitUnformatter<B, RangeSize<RngStart - Offset, RngSize>>(
-                *BitUnformatter<B, DynamicSize>::subs(Offset));
+                this->advance(Offset), this->size() - Offset);
         }
         else
         {
             return BitUnformatter<B, RangeSize<SubsSize.value, 1>>(
-                *BitUnformatter<B, DynamicSize>::subs(Offset, SubsSize.value));
+                this->advance(Offset), SubsSize.value);
         }
     }
 
-    using BitUnformatter<B, DynamicSize>::writeCollection;
-    template<std::size_t OtherRngStart, std::size_t OtherRngSize>
+    using Base::writeCollection;
+    template<BitType BitArg, std::size_t OtherRngStart,
+             std::size_t OtherRngSize>
     constexpr void writeCollection(
-        const BitUnformatter<B, RangeSize<OtherRngStart, OtherRngSize>> &other)
-        const = delete;
-    template<std::size_t OtherRngStart, std::size_t OtherRngSize>
+        const BitUnformatter<BitArg, RangeSize<OtherRngStart, OtherRngSize>>
+            &other) const = delete;
+    template<BitType BitArg, std::size_t OtherRngStart,
+             std::size_t OtherRngSize>
     requires(RngSize == 1 && OtherRngSize == 1 && RngStart == OtherRngStart)
     constexpr void writeCollection(
-        const BitUnformatter<B, RangeSize<OtherRngStart, OtherRngSize>> &other)
-        const
+        const BitUnformatter<BitArg, RangeSize<OtherRngStart, OtherRngSize>>
+            &other) const
     {
         [[maybe_unused]]
-        const auto res = BitUnformatter<B, DynamicSize>::writeCollection(other);
+        const auto res = Base::writeCollection(other);
         assert(res);
     }
 
-    using BitUnformatter<B, DynamicSize>::readCollection;
-    template<std::size_t OtherRngStart, std::size_t OtherRngSize>
+    using Base::readCollection;
+    template<BitType BitArg, std::size_t OtherRngStart,
+             std::size_t OtherRngSize>
     constexpr void readCollection(
-        const BitUnformatter<B, RangeSize<OtherRngStart, OtherRngSize>> &other)
-        const = delete;
-    template<std::size_t OtherRngStart, std::size_t OtherRngSize>
+        const BitUnformatter<BitArg, RangeSize<OtherRngStart, OtherRngSize>>
+            &other) const = delete;
+    template<BitType BitArg, std::size_t OtherRngStart,
+             std::size_t OtherRngSize>
     requires(RngSize == 1 && OtherRngSize == 1 && RngStart == OtherRngStart)
     constexpr void readCollection(
-        const BitUnformatter<B, RangeSize<OtherRngStart, OtherRngSize>> &other)
-        const
+        const BitUnformatter<BitArg, RangeSize<OtherRngStart, OtherRngSize>>
+            &other) const
     {
         [[maybe_unused]]
-        const auto res = BitUnformatter<B, DynamicSize>::readCollection(other);
+        const auto res = Base::readCollection(other);
         assert(res);
     }
 
-    using BitUnformatter<B, DynamicSize>::writeRepr;
-    template<auto Value>
-    requires(BitUnformatter<B, DynamicSize>::isRepresentable(Value, RngStart) &&
-             RngSize == 1)
-    constexpr void writeRepr() const
+    using Base::andWith;
+    template<BitType BitArg, std::size_t OtherRngStart,
+             std::size_t OtherRngSize>
+    constexpr void andWith(
+        const BitUnformatter<BitArg, RangeSize<OtherRngStart, OtherRngSize>>
+            &other) const = delete;
+    template<BitType BitArg, std::size_t OtherRngStart,
+             std::size_t OtherRngSize>
+    requires(std::same_as<B, Bit> && RngSize == 1 && OtherRngSize == 1 &&
+             RngStart == OtherRngStart)
+    constexpr void andWith(
+        const BitUnformatter<BitArg, RangeSize<OtherRngStart, OtherRngSize>>
+            &other) const
+    {
+        [[maybe_unused]]
+        const auto res = Base::andWith(other);
+        assert(res);
+    }
+
+    using Base::orWith;
+    template<BitType BitArg, std::size_t OtherRngStart,
+             std::size_t OtherRngSize>
+    constexpr void orWith(
+        const BitUnformatter<BitArg, RangeSize<OtherRngStart, OtherRngSize>>
+            &other) const = delete;
+    template<BitType BitArg, std::size_t OtherRngStart,
+             std::size_t OtherRngSize>
+    requires(std::same_as<B, Bit> && RngSize == 1 && OtherRngSize == 1 &&
+             RngStart == OtherRngStart)
+    constexpr void orWith(
+        const BitUnformatter<BitArg, RangeSize<OtherRngStart, OtherRngSize>>
+            &other) const
+    {
+        [[maybe_unused]]
+        const auto res = Base::orWith(other);
+        assert(res);
+    }
+
+    using Base::xorWith;
+    template<BitType BitArg, std::size_t OtherRngStart,
+             std::size_t OtherRngSize>
+    constexpr void xorWith(
+        const BitUnformatter<BitArg, RangeSize<OtherRngStart, OtherRngSize>>
+            &other) const = delete;
+    template<BitType BitArg, std::size_t OtherRngStart,
+             std::size_t OtherRngSize>
+    requires(std::same_as<B, Bit> && RngSize == 1 && OtherRngSize == 1 &&
+             RngStart == OtherRngStart)
+    constexpr void xorWith(
+        const BitUnformatter<BitArg, RangeSize<OtherRngStart, OtherRngSize>>
+            &other) const
     {
         [[maybe_unused]]
-        const auto res = BitUnformatter<B, DynamicSize>::writeRepr(Value);
+        const auto res = Base::xorWith(other);
         assert(res);
     }
 
+    using Base::writeRepr;
+    template<auto Value>
+    requires(Base::isRepresentable(Value, RngStart) && RngSize == 1)
+    constexpr void writeRepr() const
+    {
+        this->template storeRepr<RngStart>(Value, RngStart);
+    }
+
+    // Consecutive fields of the given widths covering the range. All values
+    // are combined in a register and stored with one masked store, returns
+    // false when a value doesn't fit its field.
+    template<std::size_t... Widths, typename... V>
+    bool writeFields(const V... values) const = delete;
+    template<std::size_t... Widths, typename... V>
+    requires(RngSize == 1 && (std::integral<V> && ...) &&
+             sizeof...(Widths) == sizeof...(V) &&
+             inner::isFieldGroup<RngStart, Widths...>())
+    [[nodiscard]]
+    constexpr bool writeFields(const V... values) const
+    {
+        constexpr auto SHIFTS = inner::fieldShifts<Widths...>();
+        if(!(Base::isRepresentable(values, Widths) & ...))
+        {
+            stats::Policy::boundsFailure(stats::Site::bitWriteRepr);
+            return false;
+        }
+        const auto combined =
+            [&]<std::size_t... Idx>(std::index_sequence<Idx...>) {
+                return ((static_cast<std::uint64_t>(values) << SHIFTS[Idx]) |
+                        ...);
+            }(std::index_sequence_for<V...>{});
+        this->template storeStaticBits<RngStart>(combined);
+        return true;
+    }
+
+    // Loads the range once and extracts every field with shifts.
+    template<std::size_t... Widths>
+    std::array<std::uint64_t, sizeof...(Widths)> readFields() const = delete;
+    template<std::size_t... Widths>
+    requires(RngSize == 1 && inner::isFieldGroup<RngStart, Widths...>())
+    [[nodiscard]]
+    constexpr std::array<std::uint64_t, sizeof...(Widths)> readFields() const
+    {
+        constexpr auto SHIFTS = inner::fieldShifts<Widths...>();
+        const auto word = this->template loadStaticBits<RngStart>();
+        return [&]<std::size_t... Idx>(std::index_sequence<Idx...>) {
+            return std::array<std::uint64_t, sizeof...(Widths)>{
+                (word >> SHIFTS[Idx] &
+                 ~std::uint64_t{0} >> (inner::bitutil::WORD_BITS - Widths))...};
+        }(std::make_index_sequence<sizeof...(Widths)>{});
+    }
+
 private:
     explicit constexpr BitUnformatter(
         const BitUnformatter<B, DynamicSize> &that)
-        : BitUnformatter<B, DynamicSize>(that)
+        : Base(that.data_, that.bitOffset_, that.size())
+    {
+    }
+
+    constexpr BitUnformatter(
+        const std::pair<typename B::Byte *, std::size_t> &position,
+        const std::size_t bitSize)
+        : Base(position.first, position.second, bitSize)
     {
     }
 };
@@ -374,13 +802,13 @@ constexpr auto createBit(V &val)
                           RangeSize<sizeof(V) * inner::bitutil::BYTE_BIT, 1>>(
         val);
 }
-template<std::size_t RngStart, std::size_t RngSize, typename V>
+template<std::size_t RngStart, std::size_t RngSize, std::size_t RngAlignment,
+         typename V>
 constexpr auto createBit(
-    const Unformatter<V, RangeSize<RngStart, RngSize>> &other)
+    const Unformatter<V, RangeSize<RngStart, RngSize, RngAlignment>> &other)
 {
     return BitUnformatter<typename inner::ToBit<V>::Type,
-                          RangeSize<RngStart * inner::bitutil::BYTE_BIT,
-                                    RngSize * inner::bitutil::BYTE_BIT>>(other);
+                          inner::BitRangeSize<V, RngStart, RngSize>>(other);
 }
 }
 
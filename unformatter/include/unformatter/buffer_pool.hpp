@@ -0,0 +1,266 @@
+#ifndef UNFORMATTER_BUFFER_POOL_HPP
+#define UNFORMATTER_BUFFER_POOL_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <optional>
+#include <span>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#include "unformatter/unformatter.hpp"
+
+namespace unformatter
+{
+struct BufferPoolOptions
+{
+    // Backs the buffers with transparent huge pages where supported.
+    bool hugePages = false;
+};
+
+// Fixed number of Size byte buffers from a single slab. Free buffers are kept
+// in a lock-free stack, both acquire and release are O(1). Buffers are handed
+// out already wrapped in an unformatter of the buffer size and alignment.
+template<std::size_t Size, std::size_t Alignment = 64>
+requires(Size > 0 && std::has_single_bit(Alignment))
+class BufferPool
+{
+    static constexpr std::size_t STRIDE =
+        (Size + Alignment - 1) / Alignment * Alignment;
+    static constexpr std::size_t HUGE_PAGE_SIZE = std::size_t{2} << 20;
+    static constexpr std::size_t CACHE_LINE_SIZE = 64;
+    static constexpr std::uint32_t EMPTY = 0;
+    static constexpr unsigned int TAG_SHIFT = 32;
+
+public:
+    using Buffer = UnformatterStatic<std::byte, Size, Alignment>;
+
+    // Per-thread cache in front of the shared stack. Buffers move between the
+    // cache and the pool in batches of half the cache, each a chain of the
+    // stack taken or given with a single exchange of its head, so most
+    // operations touch no shared state. A cache must only be used by one
+    // thread at a time and must not outlive its pool, it returns its buffers
+    // when destroyed.
+    class Cache
+    {
+        static constexpr std::size_t CAPACITY = 32;
+
+    public:
+        explicit Cache(BufferPool &pool) : pool_(&pool)
+        {
+        }
+        Cache(const Cache &) = delete;
+        Cache &operator=(const Cache &) = delete;
+        ~Cache()
+        {
+            flush(count_);
+        }
+
+        [[nodiscard]] std::optional<Buffer> acquire()
+        {
+            if(count_ == 0)
+            {
+                count_ = pool_->pop(std::span(indices_).first(CAPACITY / 2));
+                if(count_ == 0)
+                {
+                    return std::nullopt;
+                }
+            }
+            return pool_->buffer(indices_[--count_]);
+        }
+
+        void release(const Buffer &buffer)
+        {
+            if(count_ == CAPACITY)
+            {
+                flush(CAPACITY / 2);
+            }
+            indices_[count_++] = pool_->index(buffer);
+        }
+
+    private:
+        void flush(const std::size_t count)
+        {
+            count_ -= count;
+            pool_->push(std::span(indices_).subspan(count_, count));
+        }
+
+        BufferPool *pool_;
+        std::array<std::uint32_t, CAPACITY> indices_{};
+        std::size_t count_ = 0;
+    };
+
+    // Null when the slab can't be allocated.
+    [[nodiscard]] static std::unique_ptr<BufferPool> create(
+        const std::size_t capacity, const BufferPoolOptions &options = {})
+    {
+        if(capacity == 0 ||
+           capacity >= std::numeric_limits<std::uint32_t>::max() ||
+           capacity > std::numeric_limits<std::size_t>::max() / STRIDE)
+        {
+            return nullptr;
+        }
+        std::unique_ptr<BufferPool> pool(new(std::nothrow)
+                                             BufferPool(capacity, options));
+        if(!pool || !pool->slab_ || !pool->next_)
+        {
+            return nullptr;
+        }
+        return pool;
+    }
+
+    BufferPool(const BufferPool &) = delete;
+    BufferPool &operator=(const BufferPool &) = delete;
+    ~BufferPool()
+    {
+        if(slab_)
+        {
+            ::operator delete(slab_, std::align_val_t{slabAlignment_});
+        }
+    }
+
+    [[nodiscard]] std::size_t capacity() const
+    {
+        return capacity_;
+    }
+
+    [[nodiscard]] std::optional<Buffer> acquire()
+    {
+        std::uint32_t top = 0;
+        if(pop(std::span(&top, 1)) == 0)
+        {
+            return std::nullopt;
+        }
+        return buffer(top);
+    }
+
+    // The buffer must come from this pool.
+    void release(const Buffer &buffer)
+    {
+        const auto bufferIndex = index(buffer);
+        push(std::span(&bufferIndex, 1));
+    }
+
+private:
+    BufferPool(const std::size_t capacity, const BufferPoolOptions &options)
+        : capacity_(capacity),
+          slabAlignment_(options.hugePages
+                             ? std::max(Alignment, HUGE_PAGE_SIZE)
+                             : Alignment),
+          slab_(static_cast<std::byte *>(
+              ::operator new(capacity * STRIDE,
+                             std::align_val_t{slabAlignment_}, std::nothrow))),
+          next_(new(std::nothrow) std::atomic<std::uint32_t>[capacity])
+    {
+        if(!slab_ || !next_)
+        {
+            return;
+        }
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        if(options.hugePages)
+        {
+            // Only a hint, the buffers work without huge pages.
+            ::madvise(slab_, capacity * STRIDE, MADV_HUGEPAGE);
+        }
+#endif
+        for(std::size_t idx = 0; idx < capacity; ++idx)
+        {
+            next_[idx].store(idx + 1 < capacity
+                                 ? static_cast<std::uint32_t>(idx + 2)
+                                 : EMPTY,
+                             std::memory_order_relaxed);
+        }
+        head_.store(1, std::memory_order_release);
+    }
+
+    Buffer buffer(const std::uint32_t index) const
+    {
+        return *createAligned<Alignment, Size>(
+            std::span<std::byte, Size>(slab_ + index * STRIDE, Size));
+    }
+
+    std::uint32_t index(const Buffer &buffer) const
+    {
+        const auto offset =
+            static_cast<std::size_t>((*buffer).data() - slab_);
+        assert(offset % STRIDE == 0 && offset / STRIDE < capacity_);
+        return static_cast<std::uint32_t>(offset / STRIDE);
+    }
+
+    // The head keeps the top index plus one in the low half and a change
+    // counter in the high half, which prevents ABA on concurrent pops. Pops
+    // up to indices.size() buffers and returns how many, the links walked
+    // are only used when the head didn't change meanwhile.
+    std::size_t pop(const std::span<std::uint32_t> indices)
+    {
+        auto head = head_.load(std::memory_order_acquire);
+        while(true)
+        {
+            std::size_t count = 0;
+            auto top = static_cast<std::uint32_t>(head);
+            for(; count < indices.size() && top != EMPTY; ++count)
+            {
+                indices[count] = top - 1;
+                top = next_[top - 1].load(std::memory_order_relaxed);
+            }
+            if(count == 0)
+            {
+                return 0;
+            }
+            if(head_.compare_exchange_weak(head, nextHead(head, top),
+                                           std::memory_order_acquire,
+                                           std::memory_order_acquire))
+            {
+                return count;
+            }
+        }
+    }
+
+    // Links the buffers into a chain and puts it on top, the first index
+    // ends up topmost.
+    void push(const std::span<const std::uint32_t> indices)
+    {
+        if(indices.empty())
+        {
+            return;
+        }
+        for(std::size_t idx = 0; idx + 1 < indices.size(); ++idx)
+        {
+            next_[indices[idx]].store(indices[idx + 1] + 1,
+                                      std::memory_order_relaxed);
+        }
+        auto head = head_.load(std::memory_order_relaxed);
+        do
+        {
+            next_[indices.back()].store(static_cast<std::uint32_t>(head),
+                                        std::memory_order_relaxed);
+        } while(!head_.compare_exchange_weak(
+            head, nextHead(head, indices.front() + 1),
+            std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    static constexpr std::uint64_t nextHead(const std::uint64_t head,
+                                            const std::uint32_t top)
+    {
+        return ((head >> TAG_SHIFT) + 1) << TAG_SHIFT | top;
+    }
+
+    std::size_t capacity_;
+    std::size_t slabAlignment_;
+    std::byte *slab_;
+    std::unique_ptr<std::atomic<std::uint32_t>[]> next_;
+    alignas(CACHE_LINE_SIZE) std::atomic<std::uint64_t> head_{EMPTY};
+};
+}
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef UNFORMATTER_CHECK_HPP
+#define UNFORMATTER_CHECK_HPP
+
+#include <cassert>
+#include <concepts>
+
+namespace unformatter
+{
+// Policies of the unchecked accessors, for bounds already proven by the
+// caller. The regular accessors are the checked mode and report failures
+// through their results.
+
+// Asserts the bounds, so only release builds skip them.
+struct DebugChecked
+{
+    static constexpr void check([[maybe_unused]] const bool valid)
+    {
+        assert(valid);
+    }
+};
+
+// Trusts the bounds in every build, violating them is undefined behavior.
+struct Unchecked
+{
+    static constexpr void check(bool)
+    {
+    }
+};
+
+template<typename C>
+concept CheckPolicy = requires(const bool valid) {
+    { C::check(valid) } -> std::same_as<void>;
+};
+}
+
+#endif
@@ -0,0 +1,300 @@
+#ifndef UNFORMATTER_DISPATCH_HPP
+#define UNFORMATTER_DISPATCH_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "unformatter/size.hpp"
+#include "unformatter/unformatter.hpp"
+
+namespace unformatter
+{
+template<typename K>
+concept DispatchKey = std::integral<K> || std::is_enum_v<K>;
+
+template<auto Key, auto Handler>
+requires DispatchKey<decltype(Key)>
+struct DispatchCase
+{
+    static constexpr auto key = Key;
+    static constexpr auto handler = Handler;
+};
+
+namespace inner
+{
+    template<typename K>
+    using DispatchUnsigned = std::make_unsigned_t<
+        typename std::conditional_t<std::is_enum_v<K>, std::underlying_type<K>,
+                                    std::type_identity<K>>::type>;
+
+    template<typename K>
+    constexpr std::uint64_t dispatchBits(const K key)
+    {
+        return static_cast<DispatchUnsigned<K>>(key);
+    }
+
+    constexpr std::uint64_t splitMix(std::uint64_t &state)
+    {
+        state += 0x9e3779b97f4a7c15;
+        auto value = state;
+        value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9;
+        value = (value ^ (value >> 27)) * 0x94d049bb133111eb;
+        return value ^ (value >> 31);
+    }
+
+    struct PerfectHash
+    {
+        std::uint64_t multiplier = 0;
+        unsigned int bits = 0;
+
+        constexpr std::size_t operator()(const std::uint64_t key) const
+        {
+            return static_cast<std::size_t>((key * multiplier) >>
+                                            (64 - bits));
+        }
+    };
+
+    // Multiplicative hash without collisions for the keys, tables up to 8
+    // times the key count are tried.
+    template<std::size_t Count>
+    consteval std::optional<PerfectHash> findPerfectHash(
+        const std::array<std::uint64_t, Count> &keys)
+    {
+        constexpr unsigned int MAX_EXTRA_BITS = 3;
+        constexpr std::size_t ATTEMPTS = 256;
+        constexpr auto MAX_SIZE = std::size_t{1}
+                                  << (std::bit_width(Count) + MAX_EXTRA_BITS);
+        const auto minBits = std::max(
+            1U, static_cast<unsigned int>(std::bit_width(Count - 1)));
+        std::uint64_t state = 0;
+        for(auto bits = minBits; bits <= minBits + MAX_EXTRA_BITS; ++bits)
+        {
+            for(std::size_t attempt = 0; attempt < ATTEMPTS; ++attempt)
+            {
+                const PerfectHash hash{splitMix(state) | 1, bits};
+                std::array<bool, MAX_SIZE> used{};
+                bool collision = false;
+                for(const auto key : keys)
+                {
+                    auto &slot = used[hash(key)];
+                    collision = collision || slot;
+                    slot = true;
+                }
+                if(!collision)
+                {
+                    return hash;
+                }
+            }
+        }
+        return std::nullopt;
+    }
+
+    template<typename T, typename F>
+    using SizeDispatchResult =
+        std::invoke_result_t<F &, const Unformatter<T, DynamicSize> &>;
+
+    template<typename T, typename F>
+    using SizeBranch = SizeDispatchResult<T, F> (*)(
+        const Unformatter<T, DynamicSize> &, F &);
+
+    template<typename T, typename F>
+    constexpr SizeDispatchResult<T, F> dynamicSizeBranch(
+        const Unformatter<T, DynamicSize> &unformatter, F &func)
+    {
+        return func(unformatter);
+    }
+
+    // The span extent makes the size check of create constant.
+    template<std::size_t Size, typename T, typename F>
+    constexpr SizeDispatchResult<T, F> staticSizeBranch(
+        const Unformatter<T, DynamicSize> &unformatter, F &func)
+    {
+        return func(*Unformatter<T, StaticSize<Size>>::create(
+            std::span<T, Size>((*unformatter).data(), Size)));
+    }
+
+    // Branches indexed by the size minus the smallest listed size.
+    template<typename T, typename F, std::size_t... Sizes>
+    constexpr auto SIZE_BRANCHES = [] {
+        constexpr auto MIN_SIZE = std::min({Sizes...});
+        std::array<SizeBranch<T, F>, std::max({Sizes...}) - MIN_SIZE + 1>
+            branches{};
+        branches.fill(&dynamicSizeBranch<T, F>);
+        ((branches[Sizes - MIN_SIZE] = &staticSizeBranch<Sizes, T, F>), ...);
+        return branches;
+    }();
+}
+
+// Handler lookup built at compile time from the cases. Keys spanning a short
+// range get a dense table indexed by the key offset, other keys a perfect
+// hash table. Lookups compare once and select the handler without branches,
+// unknown keys get Fallback.
+template<auto Fallback, typename... Cases>
+requires(sizeof...(Cases) > 0 &&
+         (std::same_as<std::remove_cv_t<decltype(Cases::handler)>,
+                       decltype(Fallback)> &&
+          ...))
+class DispatchTable
+{
+public:
+    using Key = std::common_type_t<std::remove_cv_t<decltype(Cases::key)>...>;
+    using Handler = decltype(Fallback);
+
+    static constexpr Handler fallback = Fallback;
+
+private:
+    static_assert(
+        (std::same_as<std::remove_cv_t<decltype(Cases::key)>, Key> && ...),
+        "dispatch keys must have the same type");
+
+    static constexpr std::size_t COUNT = sizeof...(Cases);
+    static constexpr std::array<std::uint64_t, COUNT> KEYS{
+        inner::dispatchBits(Cases::key)...};
+    static constexpr std::array<Handler, COUNT> HANDLERS{Cases::handler...};
+
+    static_assert(
+        [] {
+            auto keys = KEYS;
+            std::ranges::sort(keys);
+            return std::ranges::adjacent_find(keys) == keys.end();
+        }(),
+        "dispatch keys must be unique");
+
+    using UnsignedKey = inner::DispatchUnsigned<Key>;
+
+    static constexpr Key MIN_KEY = std::min({Cases::key...});
+    static constexpr std::uint64_t RANGE =
+        static_cast<UnsignedKey>(static_cast<UnsignedKey>(
+                                     std::max({Cases::key...})) -
+                                 static_cast<UnsignedKey>(MIN_KEY)) +
+        std::uint64_t{1};
+    static constexpr std::size_t MAX_DENSE_RANGE =
+        std::max<std::size_t>(4 * COUNT, 16);
+
+public:
+    static constexpr bool dense = RANGE <= MAX_DENSE_RANGE;
+
+private:
+    static constexpr auto HASH = [] {
+        if constexpr(dense)
+        {
+            return inner::PerfectHash{};
+        }
+        else
+        {
+            constexpr auto MAYBE_HASH = inner::findPerfectHash(KEYS);
+            static_assert(MAYBE_HASH.has_value(),
+                          "no perfect hash found for the dispatch keys");
+            return *MAYBE_HASH;
+        }
+    }();
+    static constexpr std::size_t TABLE_SIZE =
+        dense ? static_cast<std::size_t>(RANGE) : std::size_t{1} << HASH.bits;
+
+    static constexpr std::size_t denseSlot(const std::uint64_t key)
+    {
+        return static_cast<UnsignedKey>(
+            static_cast<UnsignedKey>(key) -
+            static_cast<UnsignedKey>(MIN_KEY));
+    }
+
+    static constexpr auto TABLE = [] {
+        std::array<std::uint64_t, TABLE_SIZE> keys{};
+        std::array<Handler, TABLE_SIZE> handlers{};
+        std::array<bool, TABLE_SIZE> used{};
+        handlers.fill(Fallback);
+        for(std::size_t idx = 0; idx < COUNT; ++idx)
+        {
+            const auto slot = dense ? denseSlot(KEYS[idx]) : HASH(KEYS[idx]);
+            keys[slot] = KEYS[idx];
+            handlers[slot] = HANDLERS[idx];
+            used[slot] = true;
+        }
+        // Empty hash slots keep a key that can't hash to them.
+        for(std::size_t slot = 0; slot < TABLE_SIZE; ++slot)
+        {
+            if(!dense && !used[slot])
+            {
+                keys[slot] = KEYS[HASH(KEYS[0]) == slot ? 1 : 0];
+            }
+        }
+        return std::pair{keys, handlers};
+    }();
+
+public:
+    static constexpr Handler lookup(const Key key)
+    {
+        const auto bits = inner::dispatchBits(key);
+        if constexpr(dense)
+        {
+            const auto slot = denseSlot(bits);
+            return slot < TABLE_SIZE ? TABLE.second[slot] : Fallback;
+        }
+        else
+        {
+            const auto slot = HASH(bits);
+            return TABLE.first[slot] == bits ? TABLE.second[slot] : Fallback;
+        }
+    }
+};
+
+// Reads the key from a field of the key size and calls its handler with the
+// arguments. A dynamic field of another size calls the fallback.
+template<std::endian Endian = std::endian::native, typename U, typename Table,
+         typename... Args>
+constexpr decltype(auto) dispatch(const U &field, const Table &,
+                                  Args &&...args)
+{
+    const auto key = field.template read<typename Table::Key, Endian>();
+    if constexpr(std::same_as<std::remove_cv_t<decltype(key)>,
+                              typename Table::Key>)
+    {
+        return Table::lookup(key)(std::forward<Args>(args)...);
+    }
+    else
+    {
+        return (key ? Table::lookup(*key) : Table::fallback)(
+            std::forward<Args>(args)...);
+    }
+}
+
+// Calls func with the unformatter converted to UnformatterStatic<T, Size>
+// when its size is one of Sizes, so each listed size runs code specialized
+// for it. Other sizes call func with the dynamic unformatter. The branch is
+// selected through a table indexed by the size, every call of func must
+// return the same type.
+template<std::size_t... Sizes, typename T, typename F>
+requires(sizeof...(Sizes) > 0 &&
+         std::invocable<F &, const Unformatter<T, DynamicSize> &> &&
+         (std::same_as<
+              std::invoke_result_t<F &, Unformatter<T, StaticSize<Sizes>>>,
+              inner::SizeDispatchResult<T, F>> &&
+          ...))
+constexpr decltype(auto) dispatchSize(
+    const Unformatter<T, DynamicSize> &unformatter, F &&func)
+{
+    static_assert(
+        [] {
+            auto sizes = std::to_array({Sizes...});
+            std::ranges::sort(sizes);
+            return std::ranges::adjacent_find(sizes) == sizes.end();
+        }(),
+        "dispatch sizes must be unique");
+
+    constexpr auto &BRANCHES = inner::SIZE_BRANCHES<T, F, Sizes...>;
+    const auto slot = unformatter.size() - std::min({Sizes...});
+    return (slot < BRANCHES.size() ? BRANCHES[slot]
+                                   : &inner::dynamicSizeBranch<T, F>)(
+        unformatter, func);
+}
+}
+
+#endif
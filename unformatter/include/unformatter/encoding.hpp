@@ -0,0 +1,790 @@
+#ifndef UNFORMATTER_ENCODING_HPP
+#define UNFORMATTER_ENCODING_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+#include "unformatter/stats.hpp"
+#include "unformatter/unformatter.hpp"
+
+#if defined(__SSSE3__)
+#include <immintrin.h>
+#endif
+
+namespace unformatter
+{
+constexpr std::size_t hexEncodedSize(const std::size_t size)
+{
+    return 2 * size;
+}
+
+constexpr std::size_t base64EncodedSize(const std::size_t size)
+{
+    return (size + 2) / 3 * 4;
+}
+
+namespace inner
+{
+    template<typename T>
+    concept EncodingByte =
+        sizeof(T) == 1 && std::is_trivial_v<T> && !StringDataType<T>;
+
+    template<typename T>
+    concept EncodingChar = StringDataType<T>;
+
+    template<typename T>
+    concept EncodingWritable = !std::is_const_v<T>;
+
+    inline constexpr std::uint8_t INVALID_DIGIT = 0xff;
+
+    inline constexpr std::string_view BASE64_ALPHABET =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    // Digit values per character, INVALID_DIGIT for other characters. Valid
+    // digits have the high bits clear, so or-ing the looked up values of the
+    // whole input validates it after the loop.
+    inline constexpr auto HEX_DIGITS = [] {
+        std::array<std::uint8_t, 256> digits{};
+        digits.fill(INVALID_DIGIT);
+        for(std::uint8_t idx = 0; idx < 10; ++idx)
+        {
+            digits['0' + idx] = idx;
+        }
+        for(std::uint8_t idx = 0; idx < 6; ++idx)
+        {
+            digits['a' + idx] = 10 + idx;
+            digits['A' + idx] = 10 + idx;
+        }
+        return digits;
+    }();
+
+    inline constexpr auto BASE64_DIGITS = [] {
+        std::array<std::uint8_t, 256> digits{};
+        digits.fill(INVALID_DIGIT);
+        for(std::size_t idx = 0; idx < BASE64_ALPHABET.size(); ++idx)
+        {
+            digits[static_cast<unsigned char>(BASE64_ALPHABET[idx])] =
+                static_cast<std::uint8_t>(idx);
+        }
+        return digits;
+    }();
+
+    template<typename T>
+    constexpr std::uint8_t encodingByte(const T val)
+    {
+        return static_cast<std::uint8_t>(val);
+    }
+
+    template<typename T>
+    constexpr std::uint8_t encodingDigit(
+        const T chr, const std::array<std::uint8_t, 256> &digits)
+    {
+        return digits[static_cast<unsigned char>(chr)];
+    }
+
+    // Nibbles are mapped to digits arithmetically, without a branch.
+    constexpr char hexDigit(const std::uint8_t nibble)
+    {
+        const auto letter = static_cast<unsigned int>(9 - nibble) >> 8 & 1;
+        return static_cast<char>('0' + nibble + letter * ('a' - '0' - 10));
+    }
+
+#if defined(__SSSE3__)
+    // Both nibbles are looked up in a 16 digit table with pshufb and the
+    // digits interleaved high first. Returns the source bytes done.
+    inline std::size_t hexEncodeSsse3(const std::uint8_t *const src,
+                                      const std::size_t size,
+                                      std::uint8_t *const dst)
+    {
+        constexpr std::size_t BLOCK = sizeof(__m128i);
+        const auto digits =
+            _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9',
+                          'a', 'b', 'c', 'd', 'e', 'f');
+        const auto nibble = _mm_set1_epi8(0x0f);
+        std::size_t offset = 0;
+        for(; size - offset >= BLOCK; offset += BLOCK)
+        {
+            const auto block = _mm_loadu_si128(
+                reinterpret_cast<const __m128i *>(src + offset));
+            const auto high = _mm_shuffle_epi8(
+                digits, _mm_and_si128(_mm_srli_epi16(block, 4), nibble));
+            const auto low =
+                _mm_shuffle_epi8(digits, _mm_and_si128(block, nibble));
+            auto *const out = reinterpret_cast<__m128i *>(dst + 2 * offset);
+            _mm_storeu_si128(out, _mm_unpacklo_epi8(high, low));
+            _mm_storeu_si128(out + 1, _mm_unpackhi_epi8(high, low));
+        }
+        return offset;
+    }
+
+    // Digit values of 16 characters. Digits and letters are told apart by
+    // unsigned range compares, valid keeps the lanes that were either.
+    inline __m128i hexValuesSsse3(const __m128i chars, __m128i &valid)
+    {
+        const auto digit = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+        const auto letter = _mm_sub_epi8(
+            _mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+        const auto isDigit =
+            _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+        const auto isLetter =
+            _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(5)), letter);
+        valid = _mm_and_si128(valid, _mm_or_si128(isDigit, isLetter));
+        return _mm_or_si128(
+            _mm_and_si128(isDigit, digit),
+            _mm_and_si128(isLetter, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+    }
+
+    // Digit pairs are combined by a multiply-add into 16 bit lanes and
+    // packed back to bytes. Returns the destination bytes done, invalid is
+    // set when any of their digits wasn't one.
+    inline std::size_t hexDecodeSsse3(const std::uint8_t *const src,
+                                      const std::size_t size,
+                                      std::uint8_t *const dst, bool &invalid)
+    {
+        constexpr std::size_t BLOCK = sizeof(__m128i);
+        const auto weights = _mm_set1_epi16(0x0110);
+        auto valid = _mm_set1_epi8(-1);
+        std::size_t offset = 0;
+        for(; size - offset >= BLOCK; offset += BLOCK)
+        {
+            const auto *const in =
+                reinterpret_cast<const __m128i *>(src + 2 * offset);
+            const auto first = _mm_maddubs_epi16(
+                hexValuesSsse3(_mm_loadu_si128(in), valid), weights);
+            const auto second = _mm_maddubs_epi16(
+                hexValuesSsse3(_mm_loadu_si128(in + 1), valid), weights);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + offset),
+                             _mm_packus_epi16(first, second));
+        }
+        invalid = invalid || _mm_movemask_epi8(valid) != 0xffff;
+        return offset;
+    }
+
+    // Sextet indices of 4 groups. The bytes of each group are shuffled so
+    // that two 16 bit multiplies move every sextet to its own byte.
+    inline __m128i base64IndicesSsse3(const __m128i block)
+    {
+        const auto in = _mm_shuffle_epi8(
+            block, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9,
+                                 11, 10));
+        const auto high = _mm_mulhi_epu16(
+            _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00)),
+            _mm_set1_epi32(0x04000040));
+        const auto low =
+            _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003f03f0)),
+                            _mm_set1_epi32(0x01000010));
+        return _mm_or_si128(high, low);
+    }
+
+    // Indices are mapped to characters by adding an offset per alphabet
+    // range, looked up with pshufb from the saturated index.
+    inline __m128i base64CharsSsse3(const __m128i indices)
+    {
+        const auto offsets = _mm_setr_epi8(
+            'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+            '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+            '/' - 63, 'A', 0, 0);
+        const auto upper = _mm_and_si128(
+            _mm_cmpgt_epi8(_mm_set1_epi8(26), indices), _mm_set1_epi8(13));
+        const auto range =
+            _mm_or_si128(_mm_subs_epu8(indices, _mm_set1_epi8(51)), upper);
+        return _mm_add_epi8(indices, _mm_shuffle_epi8(offsets, range));
+    }
+
+    // 12 bytes to 16 characters per step, each load reads 4 bytes ahead.
+    // Returns the source bytes done.
+    inline std::size_t base64EncodeSsse3(const std::uint8_t *const src,
+                                         const std::size_t size,
+                                         std::uint8_t *const dst)
+    {
+        constexpr std::size_t STEP = 12;
+        std::size_t offset = 0;
+        for(; size - offset >= sizeof(__m128i); offset += STEP)
+        {
+            const auto block = _mm_loadu_si128(
+                reinterpret_cast<const __m128i *>(src + offset));
+            _mm_storeu_si128(
+                reinterpret_cast<__m128i *>(dst + offset / 3 * 4),
+                base64CharsSsse3(base64IndicesSsse3(block)));
+        }
+        return offset;
+    }
+
+    // Characters are classified by a table lookup of each nibble, a valid
+    // character has no bit in both. Another lookup by the high nibble gives
+    // the offset to the sextet value, '/' shares its nibble with '+' and is
+    // moved to the next entry. Returns the sextets.
+    inline __m128i base64ValuesSsse3(const __m128i chars, __m128i &invalid)
+    {
+        const auto lowClass = _mm_setr_epi8(
+            0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13,
+            0x1a, 0x1b, 0x1b, 0x1b, 0x1a);
+        const auto highClass = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04,
+                                             0x08, 0x04, 0x08, 0x10, 0x10,
+                                             0x10, 0x10, 0x10, 0x10, 0x10,
+                                             0x10);
+        const auto offsets = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71,
+                                           0, 0, 0, 0, 0, 0, 0, 0);
+        const auto nibble = _mm_set1_epi8(0x0f);
+        const auto high = _mm_and_si128(_mm_srli_epi32(chars, 4), nibble);
+        const auto low = _mm_and_si128(chars, nibble);
+        invalid = _mm_or_si128(
+            invalid, _mm_and_si128(_mm_shuffle_epi8(lowClass, low),
+                                   _mm_shuffle_epi8(highClass, high)));
+        const auto slash = _mm_cmpeq_epi8(chars, _mm_set1_epi8('/'));
+        return _mm_add_epi8(
+            chars, _mm_shuffle_epi8(offsets, _mm_add_epi8(high, slash)));
+    }
+
+    // Sextets merged into 24 bit groups by two multiply-adds, then the
+    // group bytes are reordered big endian into the low 12 bytes.
+    inline __m128i base64BytesSsse3(const __m128i values)
+    {
+        const auto pairs =
+            _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+        const auto groups = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+        return _mm_shuffle_epi8(groups,
+                                _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14,
+                                              13, 12, -1, -1, -1, -1));
+    }
+
+    // 16 characters to 12 bytes per step, each store writes 4 bytes ahead
+    // that the next step or the caller overwrites. Returns the source
+    // characters done, invalid is set when any wasn't a digit.
+    inline std::size_t base64DecodeSsse3(const std::uint8_t *const src,
+                                         const std::size_t size,
+                                         std::uint8_t *const dst,
+                                         bool &invalid)
+    {
+        constexpr std::size_t BLOCK = sizeof(__m128i);
+        auto bad = _mm_setzero_si128();
+        std::size_t offset = 0;
+        for(; size - offset >= BLOCK + 8; offset += BLOCK)
+        {
+            const auto chars = _mm_loadu_si128(
+                reinterpret_cast<const __m128i *>(src + offset));
+            _mm_storeu_si128(
+                reinterpret_cast<__m128i *>(dst + offset / 4 * 3),
+                base64BytesSsse3(base64ValuesSsse3(chars, bad)));
+        }
+        invalid = invalid ||
+                  _mm_movemask_epi8(_mm_cmpeq_epi8(
+                      bad, _mm_setzero_si128())) != 0xffff;
+        return offset;
+    }
+#endif
+
+#if defined(__AVX2__)
+    // The SSSE3 kernels on both 16 byte lanes, with lane crossing
+    // permutes where the lanes don't map to halves of the output.
+    inline std::size_t hexEncodeAvx2(const std::uint8_t *const src,
+                                     const std::size_t size,
+                                     std::uint8_t *const dst)
+    {
+        constexpr std::size_t BLOCK = sizeof(__m256i);
+        const auto digits = _mm256_setr_epi8(
+            '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c',
+            'd', 'e', 'f', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9',
+            'a', 'b', 'c', 'd', 'e', 'f');
+        const auto nibble = _mm256_set1_epi8(0x0f);
+        std::size_t offset = 0;
+        for(; size - offset >= BLOCK; offset += BLOCK)
+        {
+            const auto block = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i *>(src + offset));
+            const auto high = _mm256_shuffle_epi8(
+                digits, _mm256_and_si256(_mm256_srli_epi16(block, 4), nibble));
+            const auto low =
+                _mm256_shuffle_epi8(digits, _mm256_and_si256(block, nibble));
+            const auto first = _mm256_unpacklo_epi8(high, low);
+            const auto second = _mm256_unpackhi_epi8(high, low);
+            auto *const out = reinterpret_cast<__m256i *>(dst + 2 * offset);
+            _mm256_storeu_si256(out,
+                                _mm256_permute2x128_si256(first, second, 0x20));
+            _mm256_storeu_si256(out + 1,
+                                _mm256_permute2x128_si256(first, second, 0x31));
+        }
+        return offset;
+    }
+
+    inline __m256i hexValuesAvx2(const __m256i chars, __m256i &valid)
+    {
+        const auto digit = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+        const auto letter =
+            _mm256_sub_epi8(_mm256_or_si256(chars, _mm256_set1_epi8(0x20)),
+                            _mm256_set1_epi8('a'));
+        const auto isDigit = _mm256_cmpeq_epi8(
+            _mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+        const auto isLetter = _mm256_cmpeq_epi8(
+            _mm256_min_epu8(letter, _mm256_set1_epi8(5)), letter);
+        valid = _mm256_and_si256(valid, _mm256_or_si256(isDigit, isLetter));
+        return _mm256_or_si256(
+            _mm256_and_si256(isDigit, digit),
+            _mm256_and_si256(isLetter,
+                             _mm256_add_epi8(letter, _mm256_set1_epi8(10))));
+    }
+
+    inline std::size_t hexDecodeAvx2(const std::uint8_t *const src,
+                                     const std::size_t size,
+                                     std::uint8_t *const dst, bool &invalid)
+    {
+        constexpr std::size_t BLOCK = sizeof(__m256i);
+        const auto weights = _mm256_set1_epi16(0x0110);
+        auto valid = _mm256_set1_epi8(-1);
+        std::size_t offset = 0;
+        for(; size - offset >= BLOCK; offset += BLOCK)
+        {
+            const auto *const in =
+                reinterpret_cast<const __m256i *>(src + 2 * offset);
+            const auto first = _mm256_maddubs_epi16(
+                hexValuesAvx2(_mm256_loadu_si256(in), valid), weights);
+            const auto second = _mm256_maddubs_epi16(
+                hexValuesAvx2(_mm256_loadu_si256(in + 1), valid), weights);
+            _mm256_storeu_si256(
+                reinterpret_cast<__m256i *>(dst + offset),
+                _mm256_permute4x64_epi64(_mm256_packus_epi16(first, second),
+                                         0xd8));
+        }
+        invalid = invalid || _mm256_movemask_epi8(valid) != -1;
+        return offset;
+    }
+
+    // Each lane takes 12 bytes, the second load reads 4 bytes ahead.
+    inline std::size_t base64EncodeAvx2(const std::uint8_t *const src,
+                                        const std::size_t size,
+                                        std::uint8_t *const dst)
+    {
+        constexpr std::size_t STEP = 24;
+        std::size_t offset = 0;
+        for(; size - offset >= STEP + 4; offset += STEP)
+        {
+            const auto block = _mm256_inserti128_si256(
+                _mm256_castsi128_si256(_mm_loadu_si128(
+                    reinterpret_cast<const __m128i *>(src + offset))),
+                _mm_loadu_si128(
+                    reinterpret_cast<const __m128i *>(src + offset + 12)),
+                1);
+            const auto in = _mm256_shuffle_epi8(
+                block, _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7,
+                                        10, 9, 11, 10, 1, 0, 2, 1, 4, 3, 5, 4,
+                                        7, 6, 8, 7, 10, 9, 11, 10));
+            const auto indices = _mm256_or_si256(
+                _mm256_mulhi_epu16(
+                    _mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00)),
+                    _mm256_set1_epi32(0x04000040)),
+                _mm256_mullo_epi16(
+                    _mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0)),
+                    _mm256_set1_epi32(0x01000010)));
+            const auto offsets = _mm256_setr_epi8(
+                'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+                '/' - 63, 'A', 0, 0, 'a' - 26, '0' - 52, '0' - 52, '0' - 52,
+                '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+            const auto range = _mm256_or_si256(
+                _mm256_subs_epu8(indices, _mm256_set1_epi8(51)),
+                _mm256_and_si256(
+                    _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices),
+                    _mm256_set1_epi8(13)));
+            _mm256_storeu_si256(
+                reinterpret_cast<__m256i *>(dst + offset / 3 * 4),
+                _mm256_add_epi8(indices,
+                                _mm256_shuffle_epi8(offsets, range)));
+        }
+        return offset;
+    }
+
+    // Each lane decodes into its low 12 bytes, which are moved together.
+    inline std::size_t base64DecodeAvx2(const std::uint8_t *const src,
+                                        const std::size_t size,
+                                        std::uint8_t *const dst,
+                                        bool &invalid)
+    {
+        constexpr std::size_t BLOCK = sizeof(__m256i);
+        const auto lowClass = _mm256_setr_epi8(
+            0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13,
+            0x1a, 0x1b, 0x1b, 0x1b, 0x1a, 0x15, 0x11, 0x11, 0x11, 0x11, 0x11,
+            0x11, 0x11, 0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a);
+        const auto highClass = _mm256_setr_epi8(
+            0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10,
+            0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x01, 0x02, 0x04, 0x08,
+            0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+        const auto offsets = _mm256_setr_epi8(
+            0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0, 0, 16,
+            19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+        const auto nibble = _mm256_set1_epi8(0x0f);
+        auto bad = _mm256_setzero_si256();
+        std::size_t offset = 0;
+        for(; size - offset >= BLOCK + 12; offset += BLOCK)
+        {
+            const auto chars = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i *>(src + offset));
+            const auto high =
+                _mm256_and_si256(_mm256_srli_epi32(chars, 4), nibble);
+            const auto low = _mm256_and_si256(chars, nibble);
+            bad = _mm256_or_si256(
+                bad, _mm256_and_si256(_mm256_shuffle_epi8(lowClass, low),
+                                      _mm256_shuffle_epi8(highClass, high)));
+            const auto slash = _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('/'));
+            const auto values = _mm256_add_epi8(
+                chars,
+                _mm256_shuffle_epi8(offsets, _mm256_add_epi8(high, slash)));
+            const auto groups = _mm256_madd_epi16(
+                _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140)),
+                _mm256_set1_epi32(0x00011000));
+            const auto bytes = _mm256_shuffle_epi8(
+                groups, _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13,
+                                         12, -1, -1, -1, -1, 2, 1, 0, 6, 5,
+                                         4, 10, 9, 8, 14, 13, 12, -1, -1, -1,
+                                         -1));
+            _mm256_storeu_si256(
+                reinterpret_cast<__m256i *>(dst + offset / 4 * 3),
+                _mm256_permutevar8x32_epi32(
+                    bytes, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7)));
+        }
+        invalid = invalid || _mm256_testz_si256(bad, bad) == 0;
+        return offset;
+    }
+#endif
+
+    // The vector kernels run over the longest prefix they handle, the
+    // scalar loops finish the rest and do constant evaluation. Each returns
+    // the source elements done.
+    template<typename S, typename D>
+    std::size_t hexEncodeVector(const std::span<S> src,
+                                const std::span<D> dst)
+    {
+        [[maybe_unused]] const auto *const in =
+            reinterpret_cast<const std::uint8_t *>(src.data());
+        [[maybe_unused]] auto *const out =
+            reinterpret_cast<std::uint8_t *>(dst.data());
+        std::size_t done = 0;
+#if defined(__AVX2__)
+        done = hexEncodeAvx2(in, src.size(), out);
+#endif
+#if defined(__SSSE3__)
+        done += hexEncodeSsse3(in + done, src.size() - done, out + 2 * done);
+#endif
+        return done;
+    }
+
+    template<typename S, typename D>
+    std::size_t hexDecodeVector(const std::span<S> src,
+                                const std::span<D> dst,
+                                [[maybe_unused]] bool &invalid)
+    {
+        [[maybe_unused]] const auto *const in =
+            reinterpret_cast<const std::uint8_t *>(src.data());
+        [[maybe_unused]] auto *const out =
+            reinterpret_cast<std::uint8_t *>(dst.data());
+        std::size_t done = 0;
+#if defined(__AVX2__)
+        done = hexDecodeAvx2(in, dst.size(), out, invalid);
+#endif
+#if defined(__SSSE3__)
+        done += hexDecodeSsse3(in + 2 * done, dst.size() - done, out + done,
+                               invalid);
+#endif
+        return 2 * done;
+    }
+
+    template<typename S, typename D>
+    std::size_t base64EncodeVector(const std::span<S> src,
+                                   const std::span<D> dst)
+    {
+        [[maybe_unused]] const auto *const in =
+            reinterpret_cast<const std::uint8_t *>(src.data());
+        [[maybe_unused]] auto *const out =
+            reinterpret_cast<std::uint8_t *>(dst.data());
+        std::size_t done = 0;
+#if defined(__AVX2__)
+        done = base64EncodeAvx2(in, src.size(), out);
+#endif
+#if defined(__SSSE3__)
+        done += base64EncodeSsse3(in + done, src.size() - done,
+                                  out + done / 3 * 4);
+#endif
+        return done;
+    }
+
+    // Only full groups are passed, the stores of a step may reach into the
+    // last group.
+    template<typename S, typename D>
+    std::size_t base64DecodeVector(const std::span<S> src,
+                                   const std::span<D> dst,
+                                   [[maybe_unused]] bool &invalid)
+    {
+        [[maybe_unused]] const auto *const in =
+            reinterpret_cast<const std::uint8_t *>(src.data());
+        [[maybe_unused]] auto *const out =
+            reinterpret_cast<std::uint8_t *>(dst.data());
+        std::size_t done = 0;
+#if defined(__AVX2__)
+        done = base64DecodeAvx2(in, src.size(), out, invalid);
+#endif
+#if defined(__SSSE3__)
+        done += base64DecodeSsse3(in + done, src.size() - done,
+                                  out + done / 4 * 3, invalid);
+#endif
+        return done;
+    }
+
+    template<typename S, std::size_t SrcExtent, typename D,
+             std::size_t DstExtent>
+    constexpr void hexEncode(const std::span<S, SrcExtent> src,
+                             const std::span<D, DstExtent> dst)
+    {
+        std::size_t done = 0;
+        if(!std::is_constant_evaluated())
+        {
+            done = hexEncodeVector<S, D>(src, dst);
+        }
+        for(std::size_t idx = done; idx < src.size(); ++idx)
+        {
+            const auto val = encodingByte(src[idx]);
+            dst[2 * idx] = static_cast<D>(hexDigit(val >> 4));
+            dst[2 * idx + 1] = static_cast<D>(hexDigit(val & 0xf));
+        }
+    }
+
+    template<typename S, std::size_t SrcExtent, typename D,
+             std::size_t DstExtent>
+    constexpr bool hexDecode(const std::span<S, SrcExtent> src,
+                             const std::span<D, DstExtent> dst)
+    {
+        std::uint8_t invalid = 0;
+        bool vectorInvalid = false;
+        std::size_t done = 0;
+        if(!std::is_constant_evaluated())
+        {
+            done = hexDecodeVector<S, D>(src, dst, vectorInvalid) / 2;
+        }
+        for(std::size_t idx = done; idx < dst.size(); ++idx)
+        {
+            const auto high = encodingDigit(src[2 * idx], HEX_DIGITS);
+            const auto low = encodingDigit(src[2 * idx + 1], HEX_DIGITS);
+            invalid |= high | low;
+            dst[idx] =
+                static_cast<D>(static_cast<std::uint8_t>(high << 4 | low));
+        }
+        return invalid < 16 && !vectorInvalid;
+    }
+
+    template<typename S, std::size_t SrcExtent, typename D,
+             std::size_t DstExtent>
+    constexpr void base64Encode(const std::span<S, SrcExtent> src,
+                                const std::span<D, DstExtent> dst)
+    {
+        const auto emit = [&dst](const std::size_t pos,
+                                 const std::uint32_t group) {
+            for(std::size_t idx = 0; idx < 4; ++idx)
+            {
+                dst[pos + idx] = static_cast<D>(
+                    BASE64_ALPHABET[group >> (18 - 6 * idx) & 0x3f]);
+            }
+        };
+        const auto full = src.size() / 3;
+        std::size_t done = 0;
+        if(!std::is_constant_evaluated())
+        {
+            done = base64EncodeVector<S, D>(src, dst) / 3;
+        }
+        for(std::size_t idx = done; idx < full; ++idx)
+        {
+            emit(4 * idx, std::uint32_t{encodingByte(src[3 * idx])} << 16 |
+                              std::uint32_t{encodingByte(src[3 * idx + 1])}
+                                  << 8 |
+                              encodingByte(src[3 * idx + 2]));
+        }
+        if(const auto rest = src.size() - 3 * full; rest > 0)
+        {
+            std::uint32_t group = std::uint32_t{encodingByte(src[3 * full])}
+                                  << 16;
+            if(rest > 1)
+            {
+                group |= std::uint32_t{encodingByte(src[3 * full + 1])} << 8;
+            }
+            emit(4 * full, group);
+            dst[4 * full + 3] = static_cast<D>('=');
+            if(rest == 1)
+            {
+                dst[4 * full + 2] = static_cast<D>('=');
+            }
+        }
+    }
+
+    template<typename S, std::size_t SrcExtent>
+    constexpr std::size_t base64Padding(const std::span<S, SrcExtent> src)
+    {
+        if(src.empty())
+        {
+            return 0;
+        }
+        return static_cast<std::size_t>(src[src.size() - 1] == '=') +
+               static_cast<std::size_t>(src[src.size() - 2] == '=');
+    }
+
+    // Full groups are decoded without branches, only the padded last group
+    // is handled separately. Padding is decoded as zero digits.
+    template<typename S, std::size_t SrcExtent, typename D,
+             std::size_t DstExtent>
+    constexpr bool base64Decode(const std::span<S, SrcExtent> src,
+                                const std::span<D, DstExtent> dst,
+                                const std::size_t padding)
+    {
+        std::uint8_t invalid = 0;
+        const auto group = [&src, &invalid](const std::size_t pos,
+                                            const std::size_t digits) {
+            std::uint32_t result = 0;
+            for(std::size_t idx = 0; idx < 4; ++idx)
+            {
+                const auto val =
+                    idx < digits ? encodingDigit(src[pos + idx], BASE64_DIGITS)
+                                 : std::uint8_t{0};
+                invalid |= val;
+                result = result << 6 | val;
+            }
+            return result;
+        };
+        const auto full = src.size() / 4 - (padding > 0 ? 1 : 0);
+        bool vectorInvalid = false;
+        std::size_t done = 0;
+        if(!std::is_constant_evaluated())
+        {
+            done = base64DecodeVector<S, D>(src.first(4 * full), dst,
+                                            vectorInvalid) /
+                   4;
+        }
+        for(std::size_t idx = done; idx < full; ++idx)
+        {
+            const auto val = group(4 * idx, 4);
+            for(std::size_t byte = 0; byte < 3; ++byte)
+            {
+                dst[3 * idx + byte] = static_cast<D>(
+                    static_cast<std::uint8_t>(val >> (16 - 8 * byte)));
+            }
+        }
+        if(padding > 0)
+        {
+            const auto val = group(4 * full, 4 - padding);
+            for(std::size_t byte = 0; byte < 3 - padding; ++byte)
+            {
+                dst[3 * full + byte] = static_cast<D>(
+                    static_cast<std::uint8_t>(val >> (16 - 8 * byte)));
+            }
+        }
+        return invalid < 64 && !vectorInvalid;
+    }
+
+    consteval bool isBase64DecodedSize(const std::size_t srcSize,
+                                       const std::size_t dstSize)
+    {
+        return srcSize % 4 == 0 && dstSize <= srcSize / 4 * 3 &&
+               dstSize + 2 >= srcSize / 4 * 3;
+    }
+}
+
+// Encoders write the exact encoded size of src to dst. When both ranges are
+// static, the sizes are checked at compile time and nothing can fail.
+// Otherwise mismatching sizes return false.
+template<inner::EncodingByte S, std::size_t SrcExtent,
+         inner::EncodingChar D, std::size_t DstExtent>
+requires inner::EncodingWritable<D> && (SrcExtent != std::dynamic_extent) &&
+         (DstExtent == hexEncodedSize(SrcExtent))
+constexpr void hexEncode(const inner::UnformatterBase<S, SrcExtent> &src,
+                         const inner::UnformatterBase<D, DstExtent> &dst)
+{
+    inner::hexEncode(*src, *dst);
+}
+template<inner::EncodingByte S, std::size_t SrcExtent,
+         inner::EncodingChar D, std::size_t DstExtent>
+requires inner::EncodingWritable<D> &&
+         (SrcExtent == std::dynamic_extent || DstExtent == std::dynamic_extent)
+[[nodiscard]] constexpr bool hexEncode(
+    const inner::UnformatterBase<S, SrcExtent> &src,
+    const inner::UnformatterBase<D, DstExtent> &dst)
+{
+    if(dst.size() != hexEncodedSize(src.size()))
+    {
+        stats::Policy::boundsFailure(stats::Site::encode);
+        return false;
+    }
+    inner::hexEncode(*src, *dst);
+    return true;
+}
+
+// Decoders validate the whole input, invalid digits return false. Upper and
+// lower case hex digits are accepted.
+template<inner::EncodingChar S, std::size_t SrcExtent,
+         inner::EncodingByte D, std::size_t DstExtent>
+requires inner::EncodingWritable<D> &&
+         (SrcExtent == std::dynamic_extent ||
+          DstExtent == std::dynamic_extent ||
+          SrcExtent == hexEncodedSize(DstExtent))
+[[nodiscard]] constexpr bool hexDecode(
+    const inner::UnformatterBase<S, SrcExtent> &src,
+    const inner::UnformatterBase<D, DstExtent> &dst)
+{
+    if(src.size() != hexEncodedSize(dst.size()))
+    {
+        stats::Policy::boundsFailure(stats::Site::decode);
+        return false;
+    }
+    return inner::hexDecode(*src, *dst);
+}
+
+// Standard alphabet with padding.
+template<inner::EncodingByte S, std::size_t SrcExtent,
+         inner::EncodingChar D, std::size_t DstExtent>
+requires inner::EncodingWritable<D> && (SrcExtent != std::dynamic_extent) &&
+         (DstExtent == base64EncodedSize(SrcExtent))
+constexpr void base64Encode(const inner::UnformatterBase<S, SrcExtent> &src,
+                            const inner::UnformatterBase<D, DstExtent> &dst)
+{
+    inner::base64Encode(*src, *dst);
+}
+template<inner::EncodingByte S, std::size_t SrcExtent,
+         inner::EncodingChar D, std::size_t DstExtent>
+requires inner::EncodingWritable<D> &&
+         (SrcExtent == std::dynamic_extent || DstExtent == std::dynamic_extent)
+[[nodiscard]] constexpr bool base64Encode(
+    const inner::UnformatterBase<S, SrcExtent> &src,
+    const inner::UnformatterBase<D, DstExtent> &dst)
+{
+    if(dst.size() != base64EncodedSize(src.size()))
+    {
+        stats::Policy::boundsFailure(stats::Site::encode);
+        return false;
+    }
+    inner::base64Encode(*src, *dst);
+    return true;
+}
+
+// The size of dst must match the padding of src.
+template<inner::EncodingChar S, std::size_t SrcExtent,
+         inner::EncodingByte D, std::size_t DstExtent>
+requires inner::EncodingWritable<D> &&
+         (SrcExtent == std::dynamic_extent ||
+          DstExtent == std::dynamic_extent ||
+          inner::isBase64DecodedSize(SrcExtent, DstExtent))
+[[nodiscard]] constexpr bool base64Decode(
+    const inner::UnformatterBase<S, SrcExtent> &src,
+    const inner::UnformatterBase<D, DstExtent> &dst)
+{
+    const auto data = *src;
+    const auto padding = data.size() % 4 == 0 ? inner::base64Padding(data)
+                                              : std::size_t{0};
+    if(data.size() % 4 != 0 || dst.size() != data.size() / 4 * 3 - padding)
+    {
+        stats::Policy::boundsFailure(stats::Site::decode);
+        return false;
+    }
+    return inner::base64Decode(data, *dst, padding);
+}
+}
+
+#endif
@@ -0,0 +1,565 @@
+#ifndef UNFORMATTER_FILTER_HPP
+#define UNFORMATTER_FILTER_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "unformatter/inner/common.hpp"
+#include "unformatter/size.hpp"
+#include "unformatter/unformatter.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace unformatter
+{
+namespace inner
+{
+    // Packets are evaluated in batches of one selection word, bit idx of
+    // the lanes belongs to packet idx of the batch.
+    inline constexpr std::size_t FILTER_LANES = 64;
+
+    using FilterLanes = std::uint64_t;
+
+    template<typename V>
+    using FilterColumn = std::array<V, FILTER_LANES>;
+
+    // Selected lanes and lanes of packets that have every field the
+    // expression reads. Selected lanes are always valid.
+    struct FilterResult
+    {
+        FilterLanes lanes;
+        FilterLanes valid;
+    };
+
+    template<typename P>
+    concept FilterPacket = requires(const P &packet) { std::span(*packet); };
+
+    using FilterBatch =
+        std::span<const Unformatter<const std::byte, DynamicSize>>;
+}
+
+// Integer of type V at the byte Offset of a packet with Endian byte order.
+template<std::size_t Offset, std::integral V,
+         std::endian Endian = std::endian::native>
+struct FilterField
+{
+    using Value = V;
+
+    static constexpr auto offset = Offset;
+    static constexpr auto size = sizeof(V);
+
+    // Packets too short for the field get a cleared valid lane.
+    template<inner::FilterPacket P>
+    constexpr inner::FilterLanes gather(const std::span<const P> batch,
+                                        inner::FilterColumn<V> &values) const
+    {
+        inner::FilterLanes valid = 0;
+        for(std::size_t idx = 0; idx < batch.size(); ++idx)
+        {
+            valid |= inner::FilterLanes{
+                         load(std::span(*batch[idx]), values[idx])}
+                     << idx;
+        }
+        return valid;
+    }
+
+private:
+    template<typename T, std::size_t Extent>
+    static constexpr bool load(const std::span<T, Extent> data, V &value)
+    {
+        if constexpr(Extent != std::dynamic_extent)
+        {
+            static_assert(Offset + size <= Extent * sizeof(T),
+                          "filter field is out of the packet");
+        }
+        else if(data.size_bytes() < Offset + size)
+        {
+            value = V{};
+            return false;
+        }
+        std::array<std::byte, size> raw{};
+        if(std::is_constant_evaluated())
+        {
+            for(std::size_t idx = 0; idx < size; ++idx)
+            {
+                raw[idx] = inner::common::loadByte(data, Offset + idx);
+            }
+        }
+        else
+        {
+            std::copy_n(std::as_bytes(data).data() + Offset, size, raw.data());
+        }
+        if constexpr(!inner::common::isNativeEndianness<Endian>())
+        {
+            raw = inner::common::swapChunks<size>(raw);
+        }
+        value = std::bit_cast<V>(raw);
+        return true;
+    }
+};
+
+template<std::size_t Offset, std::integral V,
+         std::endian Endian = std::endian::native>
+inline constexpr FilterField<Offset, V, Endian> filterField{};
+
+namespace inner
+{
+    template<typename O>
+    concept FilterOperand = requires(const O &operand,
+                                     FilterColumn<typename O::Value> &values,
+                                     const FilterBatch batch) {
+        { operand.gather(batch, values) } -> std::same_as<FilterLanes>;
+    };
+
+    template<typename E>
+    concept FilterExpression =
+        requires(const E &expr, const FilterBatch batch) {
+            { expr.evaluate(batch) } -> std::same_as<FilterResult>;
+        };
+}
+
+namespace inner
+{
+    template<typename Compare>
+    concept FilterOrdering =
+        std::same_as<Compare, std::less<>> ||
+        std::same_as<Compare, std::less_equal<>> ||
+        std::same_as<Compare, std::greater<>> ||
+        std::same_as<Compare, std::greater_equal<>>;
+
+    template<typename Compare>
+    concept FilterComparison =
+        FilterOrdering<Compare> || std::same_as<Compare, std::equal_to<>> ||
+        std::same_as<Compare, std::not_equal_to<>>;
+
+    template<typename Compare, typename V>
+    constexpr FilterLanes compareColumnScalar(const FilterColumn<V> &values,
+                                              const V value)
+    {
+        FilterLanes lanes = 0;
+        for(std::size_t idx = 0; idx < FILTER_LANES; ++idx)
+        {
+            lanes |= FilterLanes{Compare{}(values[idx], value)} << idx;
+        }
+        return lanes;
+    }
+
+#if defined(__AVX2__)
+    // Lanes of one vector compare, the sign bit of every element of the
+    // mask becomes a bit of the result.
+    template<std::size_t Size>
+    inline std::uint32_t filterMoveMask(const __m256i mask)
+    {
+        if constexpr(Size == 1)
+        {
+            return static_cast<std::uint32_t>(_mm256_movemask_epi8(mask));
+        }
+        else if constexpr(Size == 4)
+        {
+            return static_cast<std::uint32_t>(
+                _mm256_movemask_ps(_mm256_castsi256_ps(mask)));
+        }
+        else
+        {
+            return static_cast<std::uint32_t>(
+                _mm256_movemask_pd(_mm256_castsi256_pd(mask)));
+        }
+    }
+
+    struct FilterVectorMasks
+    {
+        __m256i eq;
+        __m256i gt;
+    };
+
+    // Equal and greater than masks of 32 bytes of elements of Size bytes.
+    // Unsigned elements are compared signed with the sign bits flipped.
+    template<std::size_t Size, bool Signed>
+    inline FilterVectorMasks filterCompareVector(
+        const std::byte *const values, const __m256i value)
+    {
+        auto column =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values));
+        auto constant = value;
+        const auto eq = [](const __m256i left, const __m256i right) {
+            if constexpr(Size == 1)
+            {
+                return _mm256_cmpeq_epi8(left, right);
+            }
+            else if constexpr(Size == 2)
+            {
+                return _mm256_cmpeq_epi16(left, right);
+            }
+            else if constexpr(Size == 4)
+            {
+                return _mm256_cmpeq_epi32(left, right);
+            }
+            else
+            {
+                return _mm256_cmpeq_epi64(left, right);
+            }
+        };
+        const auto gt = [](const __m256i left, const __m256i right) {
+            if constexpr(Size == 1)
+            {
+                return _mm256_cmpgt_epi8(left, right);
+            }
+            else if constexpr(Size == 2)
+            {
+                return _mm256_cmpgt_epi16(left, right);
+            }
+            else if constexpr(Size == 4)
+            {
+                return _mm256_cmpgt_epi32(left, right);
+            }
+            else
+            {
+                return _mm256_cmpgt_epi64(left, right);
+            }
+        };
+        if constexpr(!Signed)
+        {
+            const auto bias = [] {
+                if constexpr(Size == 1)
+                {
+                    return _mm256_set1_epi8(static_cast<char>(
+                        std::numeric_limits<signed char>::min()));
+                }
+                else if constexpr(Size == 2)
+                {
+                    return _mm256_set1_epi16(
+                        std::numeric_limits<short>::min());
+                }
+                else if constexpr(Size == 4)
+                {
+                    return _mm256_set1_epi32(std::numeric_limits<int>::min());
+                }
+                else
+                {
+                    return _mm256_set1_epi64x(
+                        std::numeric_limits<long long>::min());
+                }
+            }();
+            column = _mm256_xor_si256(column, bias);
+            constant = _mm256_xor_si256(constant, bias);
+        }
+        return {eq(column, constant), gt(column, constant)};
+    }
+
+    // Equal and greater than lanes of the whole column.
+    template<typename V>
+    inline std::pair<FilterLanes, FilterLanes> compareColumnAvx2(
+        const FilterColumn<V> &values, const V value)
+    {
+        constexpr auto SIZE = sizeof(V);
+        constexpr std::size_t PER_VECTOR = sizeof(__m256i) / SIZE;
+        const auto constant = [&] {
+            if constexpr(SIZE == 1)
+            {
+                return _mm256_set1_epi8(static_cast<char>(value));
+            }
+            else if constexpr(SIZE == 2)
+            {
+                return _mm256_set1_epi16(static_cast<short>(value));
+            }
+            else if constexpr(SIZE == 4)
+            {
+                return _mm256_set1_epi32(static_cast<int>(value));
+            }
+            else
+            {
+                return _mm256_set1_epi64x(static_cast<long long>(value));
+            }
+        }();
+        const auto *const data =
+            reinterpret_cast<const std::byte *>(values.data());
+        FilterLanes eq = 0;
+        FilterLanes gt = 0;
+        if constexpr(SIZE == 2)
+        {
+            // Word masks are packed to bytes, packing interleaves the
+            // 128 bit halves of the two vectors and the permute restores
+            // the order.
+            for(std::size_t idx = 0; idx < FILTER_LANES;
+                idx += 2 * PER_VECTOR)
+            {
+                const auto low = filterCompareVector<SIZE, std::is_signed_v<V>>(
+                    data + idx * SIZE, constant);
+                const auto high =
+                    filterCompareVector<SIZE, std::is_signed_v<V>>(
+                        data + (idx + PER_VECTOR) * SIZE, constant);
+                const auto pack = [](const __m256i left, const __m256i right) {
+                    return _mm256_permute4x64_epi64(
+                        _mm256_packs_epi16(left, right), 0xd8);
+                };
+                eq |= FilterLanes{filterMoveMask<1>(pack(low.eq, high.eq))}
+                      << idx;
+                gt |= FilterLanes{filterMoveMask<1>(pack(low.gt, high.gt))}
+                      << idx;
+            }
+        }
+        else
+        {
+            for(std::size_t idx = 0; idx < FILTER_LANES; idx += PER_VECTOR)
+            {
+                const auto masks =
+                    filterCompareVector<SIZE, std::is_signed_v<V>>(
+                        data + idx * SIZE, constant);
+                eq |= FilterLanes{filterMoveMask<SIZE>(masks.eq)} << idx;
+                gt |= FilterLanes{filterMoveMask<SIZE>(masks.gt)} << idx;
+            }
+        }
+        return {eq, gt};
+    }
+#endif
+
+    // Lanes where Compare{}(values[idx], value) holds. With AVX2 the column
+    // is compared a vector at a time and the masks are moved to lane bits.
+    template<typename Compare, typename V>
+    constexpr FilterLanes compareColumn(const FilterColumn<V> &values,
+                                        const V value)
+    {
+#if defined(__AVX2__)
+        if constexpr(FilterComparison<Compare> && !std::same_as<V, bool>)
+        {
+            if(!std::is_constant_evaluated())
+            {
+                const auto [eq, gt] = compareColumnAvx2(values, value);
+                if constexpr(std::same_as<Compare, std::equal_to<>>)
+                {
+                    return eq;
+                }
+                else if constexpr(std::same_as<Compare, std::not_equal_to<>>)
+                {
+                    return ~eq;
+                }
+                else if constexpr(std::same_as<Compare, std::greater<>>)
+                {
+                    return gt;
+                }
+                else if constexpr(std::same_as<Compare,
+                                               std::less_equal<>>)
+                {
+                    return ~gt;
+                }
+                else if constexpr(std::same_as<Compare, std::less<>>)
+                {
+                    return ~(gt | eq);
+                }
+                else
+                {
+                    return gt | eq;
+                }
+            }
+        }
+#endif
+        return compareColumnScalar<Compare>(values, value);
+    }
+}
+
+// Operand with bits outside of mask cleared, e.g. an address prefix.
+template<inner::FilterOperand O>
+struct FilterMasked
+{
+    using Value = typename O::Value;
+
+    O operand;
+    Value mask;
+
+    template<inner::FilterPacket P>
+    constexpr inner::FilterLanes gather(
+        const std::span<const P> batch,
+        inner::FilterColumn<Value> &values) const
+    {
+        const auto valid = operand.gather(batch, values);
+        for(auto &value : values)
+        {
+            value = static_cast<Value>(value & mask);
+        }
+        return valid;
+    }
+};
+
+template<inner::FilterOperand O, typename Compare>
+struct FilterCompare
+{
+    O operand;
+    typename O::Value value;
+
+    template<inner::FilterPacket P>
+    constexpr inner::FilterResult evaluate(
+        const std::span<const P> batch) const
+    {
+        inner::FilterColumn<typename O::Value> values{};
+        const auto valid = operand.gather(batch, values);
+        return {valid & inner::compareColumn<Compare>(values, value), valid};
+    }
+};
+
+template<inner::FilterExpression L, inner::FilterExpression R,
+         typename Combine>
+struct FilterCombine
+{
+    L left;
+    R right;
+
+    template<inner::FilterPacket P>
+    constexpr inner::FilterResult evaluate(
+        const std::span<const P> batch) const
+    {
+        const auto leftResult = left.evaluate(batch);
+        const auto rightResult = right.evaluate(batch);
+        return {Combine{}(leftResult.lanes, rightResult.lanes),
+                leftResult.valid & rightResult.valid};
+    }
+};
+
+template<inner::FilterExpression E>
+struct FilterNot
+{
+    E expr;
+
+    // Packets too short for a field of the expression stay unselected.
+    template<inner::FilterPacket P>
+    constexpr inner::FilterResult evaluate(
+        const std::span<const P> batch) const
+    {
+        const auto result = expr.evaluate(batch);
+        return {~result.lanes & result.valid, result.valid};
+    }
+};
+
+template<inner::FilterOperand O>
+constexpr FilterMasked<O> operator&(const O &operand,
+                                    const typename O::Value mask)
+{
+    return {operand, mask};
+}
+
+template<inner::FilterOperand O>
+constexpr FilterCompare<O, std::equal_to<>> operator==(
+    const O &operand, const typename O::Value value)
+{
+    return {operand, value};
+}
+template<inner::FilterOperand O>
+constexpr FilterCompare<O, std::not_equal_to<>> operator!=(
+    const O &operand, const typename O::Value value)
+{
+    return {operand, value};
+}
+template<inner::FilterOperand O>
+constexpr FilterCompare<O, std::less<>> operator<(
+    const O &operand, const typename O::Value value)
+{
+    return {operand, value};
+}
+template<inner::FilterOperand O>
+constexpr FilterCompare<O, std::less_equal<>> operator<=(
+    const O &operand, const typename O::Value value)
+{
+    return {operand, value};
+}
+template<inner::FilterOperand O>
+constexpr FilterCompare<O, std::greater<>> operator>(
+    const O &operand, const typename O::Value value)
+{
+    return {operand, value};
+}
+template<inner::FilterOperand O>
+constexpr FilterCompare<O, std::greater_equal<>> operator>=(
+    const O &operand, const typename O::Value value)
+{
+    return {operand, value};
+}
+
+// Both sides are always evaluated, lanes are combined bitwise.
+template<inner::FilterExpression L, inner::FilterExpression R>
+constexpr FilterCombine<L, R, std::bit_and<>> operator&&(const L &left,
+                                                         const R &right)
+{
+    return {left, right};
+}
+template<inner::FilterExpression L, inner::FilterExpression R>
+constexpr FilterCombine<L, R, std::bit_or<>> operator||(const L &left,
+                                                        const R &right)
+{
+    return {left, right};
+}
+template<inner::FilterExpression E>
+constexpr FilterNot<E> operator!(const E &expr)
+{
+    return {expr};
+}
+
+// Predicate over static packet fields, built from filterField comparisons
+// combined with &&, || and !. Packets are processed column-wise: each field
+// is gathered from a batch of packets, compared for the whole batch and the
+// results are packed into a selection word.
+template<inner::FilterExpression E>
+class Filter
+{
+public:
+    explicit constexpr Filter(const E &expr) : expr_(expr)
+    {
+    }
+
+    // Bit idx % 64 of selection word idx / 64 is set when packet idx
+    // matches. Returns false when selection is too short.
+    template<std::ranges::contiguous_range R>
+    requires inner::FilterPacket<std::ranges::range_value_t<R>>
+    [[nodiscard]] constexpr bool select(
+        const R &packets, const std::span<std::uint64_t> selection) const
+    {
+        using P = std::ranges::range_value_t<R>;
+        const std::span<const P> all(packets);
+        const auto words =
+            (all.size() + inner::FILTER_LANES - 1) / inner::FILTER_LANES;
+        if(selection.size() < words)
+        {
+            return false;
+        }
+        for(std::size_t word = 0; word < words; ++word)
+        {
+            const auto batch = all.subspan(
+                word * inner::FILTER_LANES,
+                std::min(inner::FILTER_LANES,
+                         all.size() - word * inner::FILTER_LANES));
+            selection[word] = pack(expr_.evaluate(batch).lanes, batch.size());
+        }
+        return true;
+    }
+
+    template<inner::FilterPacket P>
+    [[nodiscard]] constexpr bool matches(const P &packet) const
+    {
+        return (expr_.evaluate(std::span<const P>(&packet, 1)).lanes & 1) !=
+               0;
+    }
+
+private:
+    static constexpr std::uint64_t pack(const inner::FilterLanes lanes,
+                                        const std::size_t count)
+    {
+        return count == inner::FILTER_LANES
+                   ? lanes
+                   : lanes & ((std::uint64_t{1} << count) - 1);
+    }
+
+    E expr_;
+};
+}
+
+#endif
@@ -0,0 +1,140 @@
+#ifndef UNFORMATTER_HASH_HPP
+#define UNFORMATTER_HASH_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <span>
+#include <type_traits>
+
+#include "unformatter/bit.hpp"
+#include "unformatter/bit_unformatter.hpp"
+#include "unformatter/inner/common.hpp"
+#include "unformatter/size.hpp"
+#include "unformatter/unformatter.hpp"
+
+namespace unformatter
+{
+namespace inner
+{
+    // Word at a time multiply-rotate hash, not suitable against adversarial
+    // keys.
+    class WordHasher
+    {
+    public:
+        explicit constexpr WordHasher(const std::size_t size)
+            : state_(SEED ^ (static_cast<std::uint64_t>(size) * PRIME_1))
+        {
+        }
+
+        constexpr void add(const std::uint64_t word)
+        {
+            state_ = std::rotl(state_ ^ (word * PRIME_2), 31) * PRIME_1;
+        }
+
+        constexpr std::size_t finish() const
+        {
+            auto value = state_;
+            value ^= value >> 33;
+            value *= PRIME_2;
+            value ^= value >> 29;
+            value *= PRIME_3;
+            value ^= value >> 32;
+            return static_cast<std::size_t>(value);
+        }
+
+    private:
+        static constexpr std::uint64_t SEED = 0x27d4eb2f165667c5;
+        static constexpr std::uint64_t PRIME_1 = 0x9e3779b185ebca87;
+        static constexpr std::uint64_t PRIME_2 = 0xc2b2ae3d27d4eb4f;
+        static constexpr std::uint64_t PRIME_3 = 0x165667b19e3779f9;
+
+        std::uint64_t state_;
+    };
+
+    // Little endian word of Size bytes at the byte offset.
+    template<std::size_t Size, typename T, std::size_t Extent>
+    requires(Size <= sizeof(std::uint64_t))
+    constexpr std::uint64_t loadHashWord(const std::span<T, Extent> data,
+                                         const std::size_t offset,
+                                         const std::size_t size = Size)
+    {
+        std::uint64_t word = 0;
+        if(std::is_constant_evaluated())
+        {
+            for(std::size_t idx = 0; idx < size; ++idx)
+            {
+                word |= std::to_integer<std::uint64_t>(
+                            common::loadByte(data, offset + idx))
+                        << (CHAR_BIT * idx);
+            }
+            return word;
+        }
+        std::memcpy(&word, std::as_bytes(data).data() + offset, size);
+        if constexpr(std::endian::native == std::endian::big)
+        {
+            word = common::byteswap(word);
+        }
+        return word;
+    }
+}
+
+// Hash of the contents of unformatter and bit unformatter ranges, consistent
+// with their equality. Transparent, so a table keyed by one range type can be
+// searched with another.
+struct Hash
+{
+    using is_transparent = void;
+
+    template<typename T, std::size_t Extent>
+    requires inner::common::BytewiseEqual<T>
+    constexpr std::size_t operator()(
+        const inner::UnformatterBase<T, Extent> &unformatter) const
+    {
+        constexpr auto WORD_SIZE = sizeof(std::uint64_t);
+        const auto data = *unformatter;
+        const auto size = data.size_bytes();
+        inner::WordHasher hasher(size);
+        const auto full = size / WORD_SIZE * WORD_SIZE;
+        for(std::size_t offset = 0; offset < full; offset += WORD_SIZE)
+        {
+            hasher.add(inner::loadHashWord<WORD_SIZE>(data, offset));
+        }
+        if(full < size)
+        {
+            hasher.add(
+                inner::loadHashWord<WORD_SIZE>(data, full, size - full));
+        }
+        return hasher.finish();
+    }
+
+    template<BitType B, std::size_t BitExtent>
+    constexpr std::size_t operator()(
+        const inner::BitUnformatterBase<B, BitExtent> &unformatter) const
+    {
+        inner::WordHasher hasher(unformatter.size());
+        unformatter.visitWords(
+            [&hasher](const std::uint64_t word, std::size_t) {
+                hasher.add(word);
+            });
+        return hasher.finish();
+    }
+};
+}
+
+template<typename T, unformatter::SizeType S>
+requires unformatter::inner::common::BytewiseEqual<T>
+struct std::hash<unformatter::Unformatter<T, S>> : unformatter::Hash
+{
+};
+
+template<unformatter::BitType B, unformatter::SizeType S>
+struct std::hash<unformatter::BitUnformatter<B, S>> : unformatter::Hash
+{
+};
+
+#endif
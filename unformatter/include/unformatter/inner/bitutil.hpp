@@ -1,9 +1,24 @@
 #ifndef UNFORMATTER_INNER_BITUTIL_HPP
 #define UNFORMATTER_INNER_BITUTIL_HPP
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <climits>
+#include <concepts>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
 #include <optional>
+#include <span>
+#include <type_traits>
+
+#include "unformatter/inner/common.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
 
 namespace unformatter::inner::bitutil
 {
@@ -13,6 +28,7 @@ namespace inner
 }
 
 inline constexpr std::size_t BYTE_BIT = CHAR_BIT;
+inline constexpr std::size_t WORD_BITS = sizeof(std::uint64_t) * BYTE_BIT;
 
 constexpr std::byte selectBits(const std::byte val, const std::size_t offset,
                                std::optional<std::size_t> maybeSize = {})
@@ -36,6 +52,704 @@ constexpr std::byte combineBits(const std::byte cur, const std::size_t chunk,
                            (nxt & (inner::mask >> chunk)),
                        args...);
 }
+
+// Stores the lowest bits of the value at the bit offset, most significant bit
+// first. MaxBits bounds the bit count, so the byte loop has a static trip count
+// and is unrolled for small fields.
+template<std::size_t MaxBits = WORD_BITS>
+requires(MaxBits <= WORD_BITS)
+constexpr void storeBits(const std::span<std::byte> data,
+                         const std::size_t offset, const std::size_t bits,
+                         const std::uint64_t value)
+{
+    constexpr auto MAX_BYTES = (MaxBits + 2 * BYTE_BIT - 2) / BYTE_BIT;
+    constexpr std::uint64_t BYTE_MASK = 0xff;
+    if(bits == 0)
+    {
+        return;
+    }
+    const auto first = offset / BYTE_BIT;
+    const auto shift = offset % BYTE_BIT;
+    const auto count = (shift + bits + BYTE_BIT - 1) / BYTE_BIT;
+    const auto valueTop = value << (WORD_BITS - bits);
+    const auto maskTop = ~std::uint64_t{0} << (WORD_BITS - bits);
+    for(std::size_t i = 0; i < std::min<std::size_t>(MAX_BYTES, count); ++i)
+    {
+        const auto select = [&](const std::uint64_t top) {
+            if(i < sizeof(std::uint64_t))
+            {
+                return std::byte((top >> shift >>
+                                  (WORD_BITS - BYTE_BIT * (i + 1))) &
+                                 BYTE_MASK);
+            }
+            return std::byte((top << (BYTE_BIT - shift)) & BYTE_MASK);
+        };
+        const auto mask = select(maskTop);
+        auto &cur = data[first + i];
+        cur = (cur & ~mask) | (select(valueTop) & mask);
+    }
+}
+
+// Loads bits at the bit offset, most significant bit first, into the lowest
+// bits of the result. The mirror of storeBits.
+template<std::size_t MaxBits = WORD_BITS>
+requires(MaxBits <= WORD_BITS)
+constexpr std::uint64_t loadBits(const std::span<const std::byte> data,
+                                 const std::size_t offset,
+                                 const std::size_t bits)
+{
+    constexpr auto MAX_BYTES = (MaxBits + 2 * BYTE_BIT - 2) / BYTE_BIT;
+    if(bits == 0)
+    {
+        return 0;
+    }
+    const auto first = offset / BYTE_BIT;
+    const auto shift = offset % BYTE_BIT;
+    const auto count = (shift + bits + BYTE_BIT - 1) / BYTE_BIT;
+    std::uint64_t top = 0;
+    for(std::size_t i = 0; i < std::min<std::size_t>(MAX_BYTES, count); ++i)
+    {
+        const auto cur = std::to_integer<std::uint64_t>(data[first + i]);
+        if(i < sizeof(std::uint64_t))
+        {
+            top |= cur << (WORD_BITS - BYTE_BIT * (i + 1)) << shift;
+        }
+        else
+        {
+            top |= cur >> (BYTE_BIT - shift);
+        }
+    }
+    return top >> (WORD_BITS - bits);
+}
+
+namespace inner
+{
+    // Count bytes from first as the top bytes of a big endian word.
+    template<std::size_t Count>
+    constexpr std::uint64_t loadTop(const std::span<const std::byte> data,
+                                    const std::size_t first)
+    {
+        std::array<std::byte, sizeof(std::uint64_t)> bytes{};
+        if(std::is_constant_evaluated())
+        {
+            std::copy_n(data.begin() + first, Count, bytes.begin());
+        }
+        else
+        {
+            std::memcpy(bytes.data(), data.data() + first, Count);
+        }
+        auto word = std::bit_cast<std::uint64_t>(bytes);
+        if constexpr(std::endian::native == std::endian::little)
+        {
+            word = common::byteswap(word);
+        }
+        return word;
+    }
+
+    template<std::size_t Count>
+    constexpr void storeTop(const std::span<std::byte> data,
+                            const std::size_t first, std::uint64_t word)
+    {
+        if constexpr(std::endian::native == std::endian::little)
+        {
+            word = common::byteswap(word);
+        }
+        const auto bytes =
+            std::bit_cast<std::array<std::byte, sizeof(std::uint64_t)>>(word);
+        if(std::is_constant_evaluated())
+        {
+            std::copy_n(bytes.begin(), Count, data.begin() + first);
+        }
+        else
+        {
+            std::memcpy(data.data() + first, bytes.data(), Count);
+        }
+    }
+
+    // Calls access with the byte count covering Bits bits at the shift,
+    // either of the two possible counts is a compile time constant.
+    template<std::size_t Bits, typename Access>
+    constexpr decltype(auto) withCoveringBytes(const std::size_t shift,
+                                               Access &&access)
+    {
+        constexpr auto BYTES = (Bits + BYTE_BIT - 1) / BYTE_BIT;
+        if(shift + Bits <= BYTES * BYTE_BIT)
+        {
+            return access.template operator()<BYTES>();
+        }
+        return access.template operator()<BYTES + 1>();
+    }
+}
+
+// Bits fields that fit in a word at any bit offset are accessed with a
+// single load and store of the covering bytes instead of a byte loop.
+template<std::size_t Bits>
+requires(Bits > 0 && Bits + BYTE_BIT - 1 <= WORD_BITS)
+constexpr void storeWordBits(const std::span<std::byte> data,
+                             const std::size_t offset,
+                             const std::uint64_t value)
+{
+    const auto first = offset / BYTE_BIT;
+    const auto shift = offset % BYTE_BIT;
+    const auto mask = (~std::uint64_t{0} << (WORD_BITS - Bits)) >> shift;
+    const auto valueTop = (value << (WORD_BITS - Bits)) >> shift;
+    inner::withCoveringBytes<Bits>(shift, [&]<std::size_t Count>() {
+        const auto top = inner::loadTop<Count>(data, first);
+        inner::storeTop<Count>(data, first,
+                               (top & ~mask) | (valueTop & mask));
+    });
+}
+
+template<std::size_t Bits>
+requires(Bits > 0 && Bits + BYTE_BIT - 1 <= WORD_BITS)
+constexpr std::uint64_t loadWordBits(const std::span<const std::byte> data,
+                                     const std::size_t offset)
+{
+    const auto first = offset / BYTE_BIT;
+    const auto shift = offset % BYTE_BIT;
+    return inner::withCoveringBytes<Bits>(shift, [&]<std::size_t Count>() {
+        return inner::loadTop<Count>(data, first) << shift >>
+               (WORD_BITS - Bits);
+    });
+}
+
+namespace inner
+{
+    // Big endian word of the bytes from first up to end, at most 8 of them,
+    // missing bytes are zero.
+    constexpr std::uint64_t loadScanWord(const std::span<const std::byte> data,
+                                         const std::size_t first,
+                                         const std::size_t end)
+    {
+        if(end - first >= sizeof(std::uint64_t))
+        {
+            return loadTop<sizeof(std::uint64_t)>(data, first);
+        }
+        std::uint64_t word = 0;
+        for(std::size_t idx = first; idx < end; ++idx)
+        {
+            word |= std::to_integer<std::uint64_t>(data[idx])
+                    << (WORD_BITS - BYTE_BIT * (idx - first + 1));
+        }
+        return word;
+    }
+
+#if defined(__AVX2__)
+    // Nibble lookup popcount of 32 byte blocks, the byte counts are summed
+    // per block with a sum of absolute differences. Returns the bytes done.
+    inline std::size_t countOnesAvx2(const std::byte *const data,
+                                     const std::size_t size,
+                                     std::size_t &count)
+    {
+        constexpr std::size_t BLOCK = sizeof(__m256i);
+        const auto lookup = _mm256_setr_epi8(
+            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2,
+            2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+        const auto low = _mm256_set1_epi8(0x0f);
+        auto total = _mm256_setzero_si256();
+        std::size_t offset = 0;
+        for(; size - offset >= BLOCK; offset += BLOCK)
+        {
+            const auto block = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i *>(data + offset));
+            const auto high =
+                _mm256_and_si256(_mm256_srli_epi16(block, 4), low);
+            const auto counts = _mm256_add_epi8(
+                _mm256_shuffle_epi8(lookup, _mm256_and_si256(block, low)),
+                _mm256_shuffle_epi8(lookup, high));
+            total = _mm256_add_epi64(
+                total, _mm256_sad_epu8(counts, _mm256_setzero_si256()));
+        }
+        count += static_cast<std::size_t>(_mm256_extract_epi64(total, 0)) +
+                 static_cast<std::size_t>(_mm256_extract_epi64(total, 1)) +
+                 static_cast<std::size_t>(_mm256_extract_epi64(total, 2)) +
+                 static_cast<std::size_t>(_mm256_extract_epi64(total, 3));
+        return offset;
+    }
+#endif
+
+    // Set bits of whole bytes, a word at a time. Long ranges use AVX2 where
+    // the target supports it.
+    constexpr std::size_t countByteOnes(const std::span<const std::byte> data)
+    {
+        std::size_t count = 0;
+        std::size_t offset = 0;
+        if(!std::is_constant_evaluated())
+        {
+#if defined(__AVX2__)
+            constexpr std::size_t AVX2_MIN_SIZE = 256;
+            if(data.size() >= AVX2_MIN_SIZE)
+            {
+                offset = countOnesAvx2(data.data(), data.size(), count);
+            }
+#endif
+            for(; data.size() - offset >= sizeof(std::uint64_t);
+                offset += sizeof(std::uint64_t))
+            {
+                std::uint64_t word = 0;
+                std::memcpy(&word, data.data() + offset, sizeof(word));
+                count += static_cast<std::size_t>(std::popcount(word));
+            }
+        }
+        for(; offset < data.size(); ++offset)
+        {
+            count += static_cast<std::size_t>(
+                std::popcount(std::to_integer<std::uint8_t>(data[offset])));
+        }
+        return count;
+    }
+}
+
+// Set bits among bits at the bit offset.
+constexpr std::size_t countOnes(const std::span<const std::byte> data,
+                                const std::size_t offset,
+                                const std::size_t bits)
+{
+    if(bits == 0)
+    {
+        return 0;
+    }
+    const auto first = offset / BYTE_BIT;
+    const auto last = (offset + bits - 1) / BYTE_BIT;
+    const auto head = inner::mask >> (offset % BYTE_BIT);
+    const auto tail =
+        inner::mask << (BYTE_BIT - 1 - (offset + bits - 1) % BYTE_BIT);
+    const auto ones = [](const std::byte val) {
+        return static_cast<std::size_t>(
+            std::popcount(std::to_integer<std::uint8_t>(val)));
+    };
+    if(first == last)
+    {
+        return ones(data[first] & head & tail);
+    }
+    return ones(data[first] & head) + ones(data[last] & tail) +
+           inner::countByteOnes(data.subspan(first + 1, last - first - 1));
+}
+
+// Position of the first bit equal to Value among bits at the bit offset,
+// relative to the offset. The covering bytes are scanned as big endian
+// words with the bits outside of the range masked.
+template<bool Value>
+constexpr std::optional<std::size_t> findFirst(
+    const std::span<const std::byte> data, const std::size_t offset,
+    const std::size_t bits)
+{
+    const auto end = offset + bits;
+    const auto endByte = (end + BYTE_BIT - 1) / BYTE_BIT;
+    for(auto pos = offset / BYTE_BIT * BYTE_BIT; pos < end; pos += WORD_BITS)
+    {
+        auto word = inner::loadScanWord(data, pos / BYTE_BIT, endByte);
+        if constexpr(!Value)
+        {
+            word = ~word;
+        }
+        if(pos < offset)
+        {
+            word &= ~std::uint64_t{0} >> (offset - pos);
+        }
+        if(end - pos < WORD_BITS)
+        {
+            word &= ~(~std::uint64_t{0} >> (end - pos));
+        }
+        if(word != 0)
+        {
+            return pos + static_cast<std::size_t>(std::countl_zero(word)) -
+                   offset;
+        }
+    }
+    return std::nullopt;
+}
+
+namespace inner
+{
+    // Bit s of the result is set when the patternBits bits starting s bits
+    // into the byte at first are the pattern. The window is a big endian
+    // word shifted left by s with the next byte funnelled in.
+    constexpr unsigned int matchPhases(const std::span<const std::byte> data,
+                                       const std::size_t first,
+                                       const std::size_t end,
+                                       const std::uint64_t pattern,
+                                       const std::size_t patternBits)
+    {
+        const auto word = loadScanWord(data, first, end);
+        const auto next =
+            first + sizeof(std::uint64_t) < end
+                ? std::to_integer<std::uint64_t>(
+                      data[first + sizeof(std::uint64_t)])
+                : std::uint64_t{0};
+        unsigned int phases = 0;
+        for(std::size_t shift = 0; shift < BYTE_BIT; ++shift)
+        {
+            const auto window =
+                (word << shift | (shift != 0 ? next >> (BYTE_BIT - shift) : 0)) >>
+                (WORD_BITS - patternBits);
+            phases |= static_cast<unsigned int>(window == pattern) << shift;
+        }
+        return phases;
+    }
+
+#if defined(__AVX2__)
+    inline constexpr std::size_t PATTERN_AVX2_MAX_BITS =
+        WORD_BITS - BYTE_BIT;
+
+    // First byte from first up to end where the pattern matches at any of
+    // the 8 phases. The phases are compared at once against the pattern
+    // shifted into each position of the byte's big endian word, every byte
+    // up to end must have a whole word. Returns end without a match.
+    inline std::size_t findPatternAvx2(const std::byte *const data,
+                                       std::size_t first,
+                                       const std::size_t end,
+                                       const std::uint64_t pattern,
+                                       const std::size_t patternBits)
+    {
+        const auto mask = ~std::uint64_t{0} >> (WORD_BITS - patternBits);
+        const auto top = WORD_BITS - patternBits;
+        const auto phased = [&](const std::uint64_t value,
+                                const std::size_t shift) {
+            return static_cast<long long>(value << (top - shift));
+        };
+        const auto lowPatterns =
+            _mm256_setr_epi64x(phased(pattern, 0), phased(pattern, 1),
+                               phased(pattern, 2), phased(pattern, 3));
+        const auto highPatterns =
+            _mm256_setr_epi64x(phased(pattern, 4), phased(pattern, 5),
+                               phased(pattern, 6), phased(pattern, 7));
+        const auto lowMasks =
+            _mm256_setr_epi64x(phased(mask, 0), phased(mask, 1),
+                               phased(mask, 2), phased(mask, 3));
+        const auto highMasks =
+            _mm256_setr_epi64x(phased(mask, 4), phased(mask, 5),
+                               phased(mask, 6), phased(mask, 7));
+        for(; first < end; ++first)
+        {
+            std::uint64_t word = 0;
+            std::memcpy(&word, data + first, sizeof(word));
+            if constexpr(std::endian::native == std::endian::little)
+            {
+                word = common::byteswap(word);
+            }
+            const auto words =
+                _mm256_set1_epi64x(static_cast<long long>(word));
+            const auto matches = _mm256_or_si256(
+                _mm256_cmpeq_epi64(_mm256_and_si256(words, lowMasks),
+                                   lowPatterns),
+                _mm256_cmpeq_epi64(_mm256_and_si256(words, highMasks),
+                                   highPatterns));
+            if(!_mm256_testz_si256(matches, matches))
+            {
+                break;
+            }
+        }
+        return first;
+    }
+#endif
+}
+
+// Position of the first patternBits bits equal to the lowest patternBits
+// bits of the pattern among bits at the bit offset, relative to the offset.
+// Every byte is checked at its 8 bit phases with shifted word compares.
+// Long searches for patterns of up to 56 bits skip bytes without a match
+// with AVX2 where the target supports it.
+constexpr std::optional<std::size_t> findPattern(
+    const std::span<const std::byte> data, const std::size_t offset,
+    const std::size_t bits, std::uint64_t pattern,
+    const std::size_t patternBits)
+{
+    if(patternBits == 0 || patternBits > WORD_BITS || patternBits > bits)
+    {
+        return std::nullopt;
+    }
+    pattern &= ~std::uint64_t{0} >> (WORD_BITS - patternBits);
+    const auto last = offset + bits - patternBits;
+    const auto endByte = (offset + bits + BYTE_BIT - 1) / BYTE_BIT;
+    for(auto first = offset / BYTE_BIT; first * BYTE_BIT <= last; ++first)
+    {
+#if defined(__AVX2__)
+        constexpr std::size_t AVX2_MIN_SIZE = 64;
+        const auto wholeEnd =
+            std::min(endByte - std::min(endByte, sizeof(std::uint64_t) - 1),
+                     last / BYTE_BIT + 1);
+        if(!std::is_constant_evaluated() &&
+           patternBits <= inner::PATTERN_AVX2_MAX_BITS &&
+           first + AVX2_MIN_SIZE <= wholeEnd)
+        {
+            first = inner::findPatternAvx2(data.data(), first, wholeEnd,
+                                           pattern, patternBits);
+        }
+#endif
+        auto phases =
+            inner::matchPhases(data, first, endByte, pattern, patternBits);
+        const auto base = first * BYTE_BIT;
+        if(base < offset)
+        {
+            phases &= ~0U << (offset - base);
+        }
+        if(last - base < BYTE_BIT - 1)
+        {
+            phases &= ~(~0U << (last - base + 1));
+        }
+        if(phases != 0)
+        {
+            return base + static_cast<std::size_t>(std::countr_zero(phases)) -
+                   offset;
+        }
+    }
+    return std::nullopt;
+}
+
+namespace inner
+{
+    constexpr void storeScanWord(const std::span<std::byte> data,
+                                 const std::size_t first,
+                                 const std::size_t end,
+                                 const std::uint64_t word)
+    {
+        if(end - first >= sizeof(std::uint64_t))
+        {
+            storeTop<sizeof(std::uint64_t)>(data, first, word);
+            return;
+        }
+        for(std::size_t idx = first; idx < end; ++idx)
+        {
+            data[idx] = std::byte(static_cast<std::uint8_t>(
+                word >> (WORD_BITS - BYTE_BIT * (idx - first + 1))));
+        }
+    }
+
+    // Word of the bits from the bit offset, the unaligned part is funnel
+    // shifted in from the following byte. Bytes from end are zero.
+    constexpr std::uint64_t loadBitWindow(
+        const std::span<const std::byte> data, const std::size_t offset,
+        const std::size_t end)
+    {
+        const auto first = offset / BYTE_BIT;
+        const auto shift = offset % BYTE_BIT;
+        auto word = loadScanWord(data, first, end) << shift;
+        if(shift != 0 && first + sizeof(std::uint64_t) < end)
+        {
+            word |= std::to_integer<std::uint64_t>(
+                        data[first + sizeof(std::uint64_t)]) >>
+                    (BYTE_BIT - shift);
+        }
+        return word;
+    }
+
+    // Replaces the destination by the inverted source.
+    struct InvertSource
+    {
+        constexpr std::uint64_t operator()(std::uint64_t,
+                                           const std::uint64_t val) const
+        {
+            return ~val;
+        }
+    };
+
+    template<typename Op>
+    constexpr std::byte applyByte(const std::byte dst, const std::byte src,
+                                  const std::byte mask, Op &op)
+    {
+        const auto val = std::byte(static_cast<std::uint8_t>(
+            op(std::to_integer<std::uint64_t>(dst),
+               std::to_integer<std::uint64_t>(src))));
+        return (dst & ~mask) | (val & mask);
+    }
+
+#if defined(__AVX2__)
+    // 32 byte blocks of the bitwise standard operations and InvertSource.
+    // GCC 12 at -O2 keeps the word loop below scalar because the ranges may
+    // alias, so the blocks are done here. Returns the bytes done, other
+    // operations are left to the word loop.
+    template<typename Op>
+    std::size_t applyBytesAvx2(std::byte *const dst,
+                               const std::byte *const src,
+                               const std::size_t size)
+    {
+        constexpr std::size_t BLOCK = sizeof(__m256i);
+        constexpr bool KNOWN = std::same_as<Op, std::bit_and<>> ||
+                               std::same_as<Op, std::bit_or<>> ||
+                               std::same_as<Op, std::bit_xor<>> ||
+                               std::same_as<Op, InvertSource>;
+        std::size_t offset = 0;
+        for(; KNOWN && size - offset >= BLOCK; offset += BLOCK)
+        {
+            const auto left = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i *>(dst + offset));
+            const auto right = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i *>(src + offset));
+            __m256i val{};
+            if constexpr(std::same_as<Op, std::bit_and<>>)
+            {
+                val = _mm256_and_si256(left, right);
+            }
+            else if constexpr(std::same_as<Op, std::bit_or<>>)
+            {
+                val = _mm256_or_si256(left, right);
+            }
+            else if constexpr(std::same_as<Op, std::bit_xor<>>)
+            {
+                val = _mm256_xor_si256(left, right);
+            }
+            else
+            {
+                val = _mm256_xor_si256(right, _mm256_set1_epi8(-1));
+            }
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + offset),
+                                val);
+        }
+        return offset;
+    }
+#endif
+
+    // Whole bytes of the same size. Bitwise operations don't depend on the
+    // byte order, so the words are native.
+    template<typename Op>
+    constexpr void applyBytes(const std::span<std::byte> dst,
+                              const std::span<const std::byte> src, Op &op)
+    {
+        std::size_t offset = 0;
+        if(!std::is_constant_evaluated())
+        {
+#if defined(__AVX2__)
+            offset = applyBytesAvx2<std::remove_const_t<Op>>(
+                dst.data(), src.data(), dst.size());
+#endif
+            for(; dst.size() - offset >= sizeof(std::uint64_t);
+                offset += sizeof(std::uint64_t))
+            {
+                std::uint64_t dstWord = 0;
+                std::uint64_t srcWord = 0;
+                std::memcpy(&dstWord, dst.data() + offset, sizeof(dstWord));
+                std::memcpy(&srcWord, src.data() + offset, sizeof(srcWord));
+                dstWord = op(dstWord, srcWord);
+                std::memcpy(dst.data() + offset, &dstWord, sizeof(dstWord));
+            }
+        }
+        for(; offset < dst.size(); ++offset)
+        {
+            dst[offset] = applyByte(dst[offset], src[offset], mask, op);
+        }
+    }
+
+    // Whether the destination starts after the source and inside it, so a
+    // forward pass would read source bits it already replaced. Unrelated
+    // pointers don't compare in constant evaluation, so there the source
+    // bytes are searched for the destination instead.
+    constexpr bool overwritesAhead(const std::span<std::byte> dst,
+                                   const std::size_t dstOffset,
+                                   const std::span<const std::byte> src,
+                                   const std::size_t srcOffset,
+                                   const std::size_t bits)
+    {
+        const std::byte *const dstStart = dst.data() + dstOffset / BYTE_BIT;
+        const std::byte *const srcStart = src.data() + srcOffset / BYTE_BIT;
+        const auto srcBytes =
+            (srcOffset % BYTE_BIT + bits + BYTE_BIT - 1) / BYTE_BIT;
+        if(dstStart == srcStart)
+        {
+            return dstOffset % BYTE_BIT > srcOffset % BYTE_BIT;
+        }
+        if(std::is_constant_evaluated())
+        {
+            for(std::size_t i = 1; i < srcBytes; ++i)
+            {
+                if(srcStart + i == dstStart)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+        return std::less<>{}(srcStart, dstStart) &&
+               std::less<>{}(dstStart, srcStart + srcBytes);
+    }
+
+    // Combines words from the end like memmove, each source word is loaded
+    // before the destination word that may cover it is stored.
+    template<typename Op>
+    constexpr void applyBackward(const std::span<std::byte> dst,
+                                 const std::size_t dstOffset,
+                                 const std::span<const std::byte> src,
+                                 const std::size_t srcOffset,
+                                 std::size_t bits, Op &op)
+    {
+        while(bits != 0)
+        {
+            const auto count = std::min(bits, WORD_BITS);
+            bits -= count;
+            const auto srcWord = loadBits(src, srcOffset + bits, count);
+            const auto dstWord = loadBits(dst, dstOffset + bits, count);
+            storeBits(dst, dstOffset + bits, count, op(dstWord, srcWord));
+        }
+    }
+}
+
+// Replaces bits at dstOffset by op(dst, src) of them and the same number of
+// bits at srcOffset. Ranges with the same offset in their bytes are combined
+// bytewise with masked ends. Otherwise the destination is processed as
+// big endian words with the source funnel shifted to match. Overlapping
+// ranges behave like memmove: the result is as if the source was copied
+// first, a destination starting after the source is combined backwards.
+template<typename Op>
+constexpr void applyBits(const std::span<std::byte> dst,
+                         const std::size_t dstOffset,
+                         const std::span<const std::byte> src,
+                         const std::size_t srcOffset, const std::size_t bits,
+                         Op op)
+{
+    if(bits == 0)
+    {
+        return;
+    }
+    if(inner::overwritesAhead(dst, dstOffset, src, srcOffset, bits))
+    {
+        inner::applyBackward(dst, dstOffset, src, srcOffset, bits, op);
+        return;
+    }
+    const auto shift = dstOffset % BYTE_BIT;
+    if(shift == srcOffset % BYTE_BIT)
+    {
+        const auto dstFirst = dstOffset / BYTE_BIT;
+        const auto srcFirst = srcOffset / BYTE_BIT;
+        const auto last = (shift + bits - 1) / BYTE_BIT;
+        const auto head = inner::mask >> shift;
+        const auto tail =
+            inner::mask << (BYTE_BIT - 1 - (shift + bits - 1) % BYTE_BIT);
+        if(last == 0)
+        {
+            dst[dstFirst] = inner::applyByte(dst[dstFirst], src[srcFirst],
+                                             head & tail, op);
+            return;
+        }
+        dst[dstFirst] =
+            inner::applyByte(dst[dstFirst], src[srcFirst], head, op);
+        inner::applyBytes(dst.subspan(dstFirst + 1, last - 1),
+                          src.subspan(srcFirst + 1, last - 1), op);
+        dst[dstFirst + last] = inner::applyByte(
+            dst[dstFirst + last], src[srcFirst + last], tail, op);
+        return;
+    }
+    const auto dstEnd = dstOffset + bits;
+    const auto dstEndByte = (dstEnd + BYTE_BIT - 1) / BYTE_BIT;
+    const auto srcEndByte = (srcOffset + bits + BYTE_BIT - 1) / BYTE_BIT;
+    for(auto pos = dstOffset - shift; pos < dstEnd; pos += WORD_BITS)
+    {
+        const auto lead = pos < dstOffset ? shift : std::size_t{0};
+        auto mask = ~std::uint64_t{0} >> lead;
+        if(dstEnd - pos < WORD_BITS)
+        {
+            mask &= ~(~std::uint64_t{0} >> (dstEnd - pos));
+        }
+        const auto srcWord =
+            inner::loadBitWindow(src, srcOffset + pos + lead - dstOffset,
+                                 srcEndByte) >>
+            lead;
+        const auto dstWord =
+            inner::loadScanWord(dst, pos / BYTE_BIT, dstEndByte);
+        inner::storeScanWord(
+            dst, pos / BYTE_BIT, dstEndByte,
+            (dstWord & ~mask) | (op(dstWord, srcWord) & mask));
+    }
+}
 }
 
 #endif
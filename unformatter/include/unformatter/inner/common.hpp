@@ -1,10 +1,25 @@
 #ifndef UNFORMATTER_INNER_COMMON_HPP
 #define UNFORMATTER_INNER_COMMON_HPP
 
+#include <algorithm>
+#include <array>
 #include <bit>
+#include <climits>
+#include <compare>
+#include <concepts>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
 #include <optional>
 #include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
 
 namespace unformatter::inner::common
 {
@@ -58,20 +73,378 @@ consteval bool isNativeEndianness()
     return Endian == std::endian::native;
 }
 
-// TODO: maybe pass by reference
-template<std::endian Endian>
-constexpr auto asEndianBytes(const auto bytes)
+template<std::size_t Size>
+struct UnsignedOfSize
+{
+};
+template<>
+struct UnsignedOfSize<sizeof(std::uint16_t)>
+{
+    using Type = std::uint16_t;
+};
+template<>
+struct UnsignedOfSize<sizeof(std::uint32_t)>
+{
+    using Type = std::uint32_t;
+};
+template<>
+struct UnsignedOfSize<sizeof(std::uint64_t)>
+{
+    using Type = std::uint64_t;
+};
+
+template<std::size_t Size>
+concept HasUnsignedOfSize =
+    requires { typename UnsignedOfSize<Size>::Type; };
+
+// Written as a shift-or expression, compilers lower it to a single swap
+// instruction.
+template<std::unsigned_integral V>
+constexpr V byteswap(const V value)
+{
+    return [&]<std::size_t... Idx>(std::index_sequence<Idx...>) {
+        constexpr V BYTE_MASK = 0xff;
+        return static_cast<V>(
+            (((value >> (CHAR_BIT * Idx) & BYTE_MASK)
+              << (CHAR_BIT * (sizeof(V) - 1 - Idx))) |
+             ...));
+    }(std::make_index_sequence<sizeof(V)>{});
+}
+
+// Reverses every ChunkSize bytes, whole words are swapped in registers.
+template<std::size_t ChunkSize, std::size_t Size>
+requires(Size % ChunkSize == 0)
+constexpr std::array<std::byte, Size> swapChunks(
+    const std::array<std::byte, Size> &bytes)
 {
-    if constexpr(isNativeEndianness<Endian>())
+    if constexpr(ChunkSize == 1)
     {
         return bytes;
     }
+    else if constexpr(HasUnsignedOfSize<ChunkSize>)
+    {
+        using Word = typename UnsignedOfSize<ChunkSize>::Type;
+        auto words = std::bit_cast<std::array<Word, Size / ChunkSize>>(bytes);
+        for(auto &word : words)
+        {
+            word = byteswap(word);
+        }
+        return std::bit_cast<std::array<std::byte, Size>>(words);
+    }
+    else
+    {
+        auto result = bytes;
+        for(std::size_t offset = 0; offset < Size; offset += ChunkSize)
+        {
+            std::ranges::reverse(std::span(result).subspan(offset, ChunkSize));
+        }
+        return result;
+    }
+}
+
+// Byte access through bit_cast, object representations can't be reinterpreted
+// during constant evaluation.
+template<typename T, std::size_t Extent>
+constexpr std::byte loadByte(const std::span<T, Extent> data,
+                             const std::size_t idx)
+{
+    using Bytes = std::array<std::byte, sizeof(T)>;
+    return std::bit_cast<Bytes>(data[idx / sizeof(T)])[idx % sizeof(T)];
+}
+template<typename T, std::size_t Extent>
+requires(!std::is_const_v<T>)
+constexpr void storeByte(const std::span<T, Extent> data, const std::size_t idx,
+                         const std::byte val)
+{
+    using Bytes = std::array<std::byte, sizeof(T)>;
+    auto &elem = data[idx / sizeof(T)];
+    auto bytes = std::bit_cast<Bytes>(elem);
+    bytes[idx % sizeof(T)] = val;
+    elem = std::bit_cast<T>(bytes);
+}
+
+// Copies 1 to 8 bytes with at most two overlapping loads and stores, the
+// first and the last 4 bytes, the first and the last 2 bytes or a single
+// byte. A constant size folds to the exact accesses.
+inline void copyShortBytes(std::byte *const dst, const std::byte *const src,
+                           const std::size_t size)
+{
+    if(size >= sizeof(std::uint32_t))
+    {
+        std::memcpy(dst, src, sizeof(std::uint32_t));
+        std::memcpy(dst + size - sizeof(std::uint32_t),
+                    src + size - sizeof(std::uint32_t), sizeof(std::uint32_t));
+    }
+    else if(size >= sizeof(std::uint16_t))
+    {
+        std::memcpy(dst, src, sizeof(std::uint16_t));
+        std::memcpy(dst + size - sizeof(std::uint16_t),
+                    src + size - sizeof(std::uint16_t), sizeof(std::uint16_t));
+    }
+    else
+    {
+        *dst = *src;
+    }
+}
+
+// Integer stored in the first size bytes of the data, 0 < size <= sizeof(V).
+// The bytes are placed at the end of a V wide word that matches their order,
+// the least significant end for little endian and the most significant end
+// for big endian, so the word only needs the usual swap. Signed values are
+// sign extended.
+template<std::integral V, std::endian Endian, typename T, std::size_t Extent>
+constexpr V loadInteger(const std::span<T, Extent> data, const std::size_t size)
+{
+    using Unsigned = std::make_unsigned_t<V>;
+    const auto offset = Endian == std::endian::big ? sizeof(V) - size : 0;
+    std::array<std::byte, sizeof(V)> bytes{};
+    if(std::is_constant_evaluated())
+    {
+        for(std::size_t idx = 0; idx < size; ++idx)
+        {
+            bytes[offset + idx] = loadByte(data, idx);
+        }
+    }
     else
     {
-        return bytes | std::views::reverse;
+        copyShortBytes(bytes.data() + offset, std::as_bytes(data).data(),
+                       size);
+    }
+    auto value = std::bit_cast<Unsigned>(bytes);
+    if constexpr(!isNativeEndianness<Endian>())
+    {
+        value = byteswap(value);
+    }
+    if constexpr(std::is_signed_v<V>)
+    {
+        const auto shift = CHAR_BIT * (sizeof(V) - size);
+        if(shift > 0)
+        {
+            return static_cast<V>(static_cast<V>(value << shift) >> shift);
+        }
     }
+    return static_cast<V>(value);
 }
 
+// Stores the size least significant bytes of the value, the rest is dropped.
+template<std::endian Endian, std::integral V, typename T, std::size_t Extent>
+requires(!std::is_const_v<T>)
+constexpr void storeInteger(const std::span<T, Extent> data,
+                            const std::size_t size, const V val)
+{
+    auto value = static_cast<std::make_unsigned_t<V>>(val);
+    if constexpr(!isNativeEndianness<Endian>())
+    {
+        value = byteswap(value);
+    }
+    const auto bytes = std::bit_cast<std::array<std::byte, sizeof(V)>>(value);
+    const auto offset = Endian == std::endian::big ? sizeof(V) - size : 0;
+    if(std::is_constant_evaluated())
+    {
+        for(std::size_t idx = 0; idx < size; ++idx)
+        {
+            storeByte(data, idx, bytes[offset + idx]);
+        }
+    }
+    else
+    {
+        copyShortBytes(std::as_writable_bytes(data).data(),
+                       bytes.data() + offset, size);
+    }
+}
+
+template<std::integral V, typename C>
+constexpr std::optional<V> parseInteger(const std::span<C> chars,
+                                        const unsigned int base)
+{
+    constexpr auto digit = [](const char chr) -> unsigned int {
+        if(chr >= '0' && chr <= '9')
+        {
+            return chr - '0';
+        }
+        if(chr >= 'a' && chr <= 'z')
+        {
+            return chr - 'a' + 10;
+        }
+        if(chr >= 'A' && chr <= 'Z')
+        {
+            return chr - 'A' + 10;
+        }
+        return std::numeric_limits<unsigned int>::max();
+    };
+    auto rest = chars;
+    const bool negative = std::is_signed_v<V> && !rest.empty() &&
+                          rest.front() == '-';
+    if(negative)
+    {
+        rest = rest.subspan(1);
+    }
+    if(rest.empty())
+    {
+        return std::nullopt;
+    }
+    using Unsigned = std::make_unsigned_t<V>;
+    const Unsigned limit =
+        static_cast<Unsigned>(std::numeric_limits<V>::max()) + negative;
+    Unsigned result = 0;
+    for(const auto chr : rest)
+    {
+        const auto cur = digit(chr);
+        if(cur >= base || result > (limit - cur) / base)
+        {
+            return std::nullopt;
+        }
+        result = static_cast<Unsigned>(result * base + cur);
+    }
+    return static_cast<V>(negative ? Unsigned{0} - result : result);
+}
+
+// Elements equal exactly when their bytes are equal.
+template<typename T>
+concept BytewiseEqual =
+    std::has_unique_object_representations_v<std::remove_cv_t<T>>;
+
+// Elements ordered like their bytes compared as unsigned char.
+template<typename T>
+concept BytewiseOrdered =
+    sizeof(T) == 1 && (std::unsigned_integral<std::remove_cv_t<T>> ||
+                       std::same_as<std::remove_cv_t<T>, std::byte>);
+
+// Static ranges up to this size are compared as whole words without a loop
+// exit per word.
+inline constexpr std::size_t WIDE_COMPARE_MAX_SIZE = 64;
+
+#if defined(__AVX2__)
+// The same xor-or chain over 32 byte blocks ending in one vptest. Ranges of
+// 16 to 31 bytes use two overlapping 16 byte blocks.
+template<std::size_t Size>
+bool equalWideAvx2(const void *const left, const void *const right)
+{
+    const auto *const leftBytes = static_cast<const std::byte *>(left);
+    const auto *const rightBytes = static_cast<const std::byte *>(right);
+    if constexpr(Size < sizeof(__m256i))
+    {
+        const auto diff = [&](const std::size_t offset) {
+            return _mm_xor_si128(
+                _mm_loadu_si128(
+                    reinterpret_cast<const __m128i *>(leftBytes + offset)),
+                _mm_loadu_si128(
+                    reinterpret_cast<const __m128i *>(rightBytes + offset)));
+        };
+        const auto all =
+            _mm_or_si128(diff(0), diff(Size - sizeof(__m128i)));
+        return _mm_testz_si128(all, all) != 0;
+    }
+    else
+    {
+        const auto diff = [&](const std::size_t offset) {
+            return _mm256_xor_si256(
+                _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i *>(leftBytes + offset)),
+                _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i *>(rightBytes + offset)));
+        };
+        constexpr auto BLOCK_SIZE = sizeof(__m256i);
+        return [&]<std::size_t... Idx>(std::index_sequence<Idx...>) {
+            auto all = diff(Size - BLOCK_SIZE);
+            ((all = _mm256_or_si256(all, diff(Idx * BLOCK_SIZE))), ...);
+            return _mm256_testz_si256(all, all) != 0;
+        }(std::make_index_sequence<Size / BLOCK_SIZE>{});
+    }
+}
+#endif
+
+// Words are xor-ed and or-ed together, unrolled by the fold, so the compare
+// ends in a single branch. The last word may overlap the previous one. With
+// AVX2, ranges of 16 bytes and more are compared as vector blocks.
+template<std::size_t Size>
+bool equalWide(const void *const left, const void *const right)
+{
+#if defined(__AVX2__)
+    if constexpr(Size >= sizeof(__m128i))
+    {
+        return equalWideAvx2<Size>(left, right);
+    }
+#endif
+
+    const auto diff = []<std::size_t Offset>(const void *const leftPtr,
+                                             const void *const rightPtr) {
+        std::uint64_t leftWord = 0;
+        std::uint64_t rightWord = 0;
+        std::memcpy(&leftWord, static_cast<const std::byte *>(leftPtr) + Offset,
+                    sizeof(leftWord));
+        std::memcpy(&rightWord,
+                    static_cast<const std::byte *>(rightPtr) + Offset,
+                    sizeof(rightWord));
+        return leftWord ^ rightWord;
+    };
+    if constexpr(Size < sizeof(std::uint64_t))
+    {
+        return std::memcmp(left, right, Size) == 0;
+    }
+    else
+    {
+        constexpr auto WORD_SIZE = sizeof(std::uint64_t);
+        constexpr auto WORDS = Size / WORD_SIZE;
+        return [&]<std::size_t... Idx>(std::index_sequence<Idx...>) {
+            return ((diff.template operator()<Idx * WORD_SIZE>(left, right) |
+                     ...) |
+                    diff.template operator()<Size - WORD_SIZE>(left, right)) ==
+                   0;
+        }(std::make_index_sequence<WORDS>{});
+    }
+}
+
+template<typename L, std::size_t LeftExtent, typename R,
+         std::size_t RightExtent>
+constexpr bool equalRanges(const std::span<L, LeftExtent> left,
+                           const std::span<R, RightExtent> right)
+{
+    constexpr bool BYTEWISE = std::same_as<std::remove_cv_t<L>,
+                                           std::remove_cv_t<R>> &&
+                              BytewiseEqual<L>;
+    if constexpr(BYTEWISE && LeftExtent == RightExtent &&
+                 LeftExtent != std::dynamic_extent &&
+                 LeftExtent * sizeof(L) <= WIDE_COMPARE_MAX_SIZE)
+    {
+        if(!std::is_constant_evaluated())
+        {
+            return equalWide<LeftExtent * sizeof(L)>(left.data(),
+                                                     right.data());
+        }
+    }
+    else if constexpr(BYTEWISE)
+    {
+        if(!std::is_constant_evaluated())
+        {
+            return left.size() == right.size() &&
+                   (left.empty() || std::memcmp(left.data(), right.data(),
+                                                left.size_bytes()) == 0);
+        }
+    }
+    return std::ranges::equal(left, right);
+}
+
+template<typename L, std::size_t LeftExtent, typename R,
+         std::size_t RightExtent>
+constexpr auto compareRanges(const std::span<L, LeftExtent> left,
+                             const std::span<R, RightExtent> right)
+{
+    if constexpr(std::same_as<std::remove_cv_t<L>, std::remove_cv_t<R>> &&
+                 BytewiseOrdered<L>)
+    {
+        if(!std::is_constant_evaluated())
+        {
+            const auto common = std::min(left.size(), right.size());
+            const auto res =
+                common == 0 ? 0
+                            : std::memcmp(left.data(), right.data(), common);
+            return res != 0 ? res <=> 0 : left.size() <=> right.size();
+        }
+    }
+    return std::lexicographical_compare_three_way(
+        left.begin(), left.end(), right.begin(), right.end());
+}
 }
 
 #endif
@@ -0,0 +1,119 @@
+#ifndef UNFORMATTER_INNER_COPY_HPP
+#define UNFORMATTER_INNER_COPY_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <span>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Copies of at least this many bytes use non-temporal stores, so large
+// payloads don't evict the working set from the caches. Zero disables
+// streaming for the implicit copies. The default is where streaming caught
+// up with memmove on x86-64 and cached copies started evicting a 256 KiB hot
+// set, about the share of the last level cache one core keeps. Hosts with a
+// different cache per core should measure with the copy_bench target and
+// define the threshold project-wide.
+#if !defined(UNFORMATTER_STREAMING_COPY_THRESHOLD)
+#define UNFORMATTER_STREAMING_COPY_THRESHOLD (std::size_t{1} << 20)
+#endif
+
+namespace unformatter::inner::copy
+{
+inline constexpr std::size_t STREAMING_THRESHOLD =
+    UNFORMATTER_STREAMING_COPY_THRESHOLD;
+
+constexpr bool isStreamingSize(const std::size_t size)
+{
+    return STREAMING_THRESHOLD != 0 && size >= STREAMING_THRESHOLD;
+}
+
+// Whether the ranges share a byte, std::less orders pointers into
+// different objects too.
+inline bool overlaps(const std::byte *const dst, const std::byte *const src,
+                     const std::size_t size)
+{
+    return std::less<>{}(dst, src + size) && std::less<>{}(src, dst + size);
+}
+
+// Stores bypass the caches where the target supports it. The unaligned
+// head and the tail are copied normally, the fence orders the streamed
+// stores before later ones. Overlapping ranges are moved without streaming.
+inline void streamBytes(std::byte *const dst, const std::byte *const src,
+                        const std::size_t size)
+{
+    if(size == 0)
+    {
+        return;
+    }
+    if(overlaps(dst, src, size))
+    {
+        std::memmove(dst, src, size);
+        return;
+    }
+#if defined(__SSE2__)
+    constexpr std::size_t VECTOR = sizeof(__m128i);
+    constexpr std::size_t UNROLL = 4;
+    const auto misalignment = reinterpret_cast<std::uintptr_t>(dst) % VECTOR;
+    const auto head = std::min(size, (VECTOR - misalignment) % VECTOR);
+    std::memcpy(dst, src, head);
+    auto offset = head;
+    for(; size - offset >= UNROLL * VECTOR; offset += UNROLL * VECTOR)
+    {
+        for(std::size_t idx = 0; idx < UNROLL; ++idx)
+        {
+            const auto pos = offset + idx * VECTOR;
+            _mm_stream_si128(
+                reinterpret_cast<__m128i *>(dst + pos),
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + pos)));
+        }
+    }
+    for(; size - offset >= VECTOR; offset += VECTOR)
+    {
+        _mm_stream_si128(
+            reinterpret_cast<__m128i *>(dst + offset),
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + offset)));
+    }
+    std::memcpy(dst + offset, src + offset, size - offset);
+    _mm_sfence();
+#else
+    std::memcpy(dst, src, size);
+#endif
+}
+
+// Static sizes below the threshold are copied with constant size moves the
+// compiler inlines, dynamic ones by memmove, which picks block moves for
+// medium sizes. Copies from the threshold up are streamed. The ranges may
+// overlap, a constant size memmove still inlines to loads before stores.
+template<std::size_t Extent>
+void copyBytes(std::byte *const dst, const std::byte *const src,
+               const std::size_t size)
+{
+    if constexpr(Extent != std::dynamic_extent)
+    {
+        if constexpr(isStreamingSize(Extent))
+        {
+            streamBytes(dst, src, Extent);
+        }
+        else if constexpr(Extent > 0)
+        {
+            std::memmove(dst, src, Extent);
+        }
+    }
+    else if(isStreamingSize(size))
+    {
+        streamBytes(dst, src, size);
+    }
+    else if(size > 0)
+    {
+        std::memmove(dst, src, size);
+    }
+}
+}
+
+#endif
@@ -16,6 +16,14 @@ struct IsSizedType<T<Sizes...>, T> : std::bool_constant<true>
 {
 };
 
+template<std::size_t... Indices>
+consteval std::size_t lastIndex()
+{
+    constexpr std::array<std::size_t, sizeof...(Indices) + 1> indices{
+        0, Indices...};
+    return indices.back();
+}
+
 template<std::size_t... Indices>
 consteval bool areNondecreasingIndices()
 {
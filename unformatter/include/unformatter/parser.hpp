@@ -0,0 +1,433 @@
+#ifndef UNFORMATTER_PARSER_HPP
+#define UNFORMATTER_PARSER_HPP
+
+#include <algorithm>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <new>
+#include <optional>
+#include <span>
+#include <utility>
+
+#include "unformatter/size.hpp"
+#include "unformatter/unformatter.hpp"
+
+namespace unformatter
+{
+struct Need
+{
+    std::size_t size;
+};
+
+// Awaited in a Parser, resumes with the next size bytes of the stream.
+constexpr Need need(const std::size_t size)
+{
+    return Need{size};
+}
+
+namespace inner
+{
+    // Coroutine frames keep a deallocation function and the allocator after
+    // the frame, so frames from any allocator are freed the same way.
+    class ParserFrame
+    {
+        using Deallocate = void (*)(void *, std::size_t);
+
+    public:
+        template<typename Alloc>
+        static void *allocate(const std::size_t size, const Alloc &alloc)
+        {
+            using ByteAlloc = typename std::allocator_traits<
+                Alloc>::template rebind_alloc<std::byte>;
+            ByteAlloc byteAlloc(alloc);
+            auto *const frame = std::allocator_traits<ByteAlloc>::allocate(
+                byteAlloc, allocSize<ByteAlloc>(size));
+            auto *const tail = frame + tailOffset(size);
+            ::new(static_cast<void *>(tail)) Deallocate(&deallocate<ByteAlloc>);
+            ::new(static_cast<void *>(tail + sizeof(Deallocate)))
+                ByteAlloc(std::move(byteAlloc));
+            return frame;
+        }
+
+        static void free(void *const ptr, const std::size_t size)
+        {
+            auto *const tail = static_cast<std::byte *>(ptr) + tailOffset(size);
+            (*std::launder(reinterpret_cast<Deallocate *>(tail)))(ptr, size);
+        }
+
+    private:
+        static constexpr std::size_t tailOffset(const std::size_t size)
+        {
+            constexpr auto ALIGN = alignof(std::max_align_t);
+            return (size + ALIGN - 1) / ALIGN * ALIGN;
+        }
+
+        template<typename ByteAlloc>
+        static constexpr std::size_t allocSize(const std::size_t size)
+        {
+            return tailOffset(size) + sizeof(Deallocate) + sizeof(ByteAlloc);
+        }
+
+        template<typename ByteAlloc>
+        static void deallocate(void *const ptr, const std::size_t size)
+        {
+            auto *const frame = static_cast<std::byte *>(ptr);
+            auto &stored = *std::launder(reinterpret_cast<ByteAlloc *>(
+                frame + tailOffset(size) + sizeof(Deallocate)));
+            ByteAlloc byteAlloc(std::move(stored));
+            stored.~ByteAlloc();
+            std::allocator_traits<ByteAlloc>::deallocate(
+                byteAlloc, frame, allocSize<ByteAlloc>(size));
+        }
+    };
+
+    // Carry buffer of a parser, allocated with the allocator of the frame
+    // rebound to bytes. The promise type doesn't depend on the allocator, so
+    // the allocator is kept inline when it fits, otherwise in a block from
+    // itself, and used through a table of functions.
+    class ParserBuffer
+    {
+        struct Ops
+        {
+            std::byte *(*allocate)(void *alloc, std::size_t size);
+            void (*deallocate)(void *alloc, std::byte *ptr, std::size_t size);
+            void (*release)(void *alloc);
+        };
+
+    public:
+        template<typename Alloc>
+        explicit ParserBuffer(const Alloc &alloc)
+            : ops_(&OPS<ByteAllocOf<Alloc>>)
+        {
+            using ByteAlloc = ByteAllocOf<Alloc>;
+            if constexpr(fitsInline<ByteAlloc>())
+            {
+                alloc_ = ::new(static_cast<void *>(storage_)) ByteAlloc(alloc);
+            }
+            else
+            {
+                HolderAllocOf<ByteAlloc> holderAlloc(alloc);
+                auto *const holder = std::allocator_traits<
+                    HolderAllocOf<ByteAlloc>>::allocate(holderAlloc, 1);
+                alloc_ = ::new(static_cast<void *>(holder)) ByteAlloc(alloc);
+            }
+        }
+        ParserBuffer(const ParserBuffer &) = delete;
+        ParserBuffer &operator=(const ParserBuffer &) = delete;
+        ~ParserBuffer()
+        {
+            if(data_ != nullptr)
+            {
+                ops_->deallocate(alloc_, data_, capacity_);
+            }
+            ops_->release(alloc_);
+        }
+
+        [[nodiscard]] bool empty() const
+        {
+            return size_ == 0;
+        }
+        [[nodiscard]] std::size_t size() const
+        {
+            return size_;
+        }
+        [[nodiscard]] std::span<const std::byte> bytes() const
+        {
+            return {data_, size_};
+        }
+
+        // Keeps the capacity for the next need that spans chunks.
+        void clear()
+        {
+            size_ = 0;
+        }
+
+        void append(const std::span<const std::byte> input)
+        {
+            if(input.size() > capacity_ - size_)
+            {
+                const auto capacity =
+                    std::max(size_ + input.size(), 2 * capacity_);
+                auto *const data = ops_->allocate(alloc_, capacity);
+                if(data_ != nullptr)
+                {
+                    std::copy_n(data_, size_, data);
+                    ops_->deallocate(alloc_, data_, capacity_);
+                }
+                data_ = data;
+                capacity_ = capacity;
+            }
+            std::copy(input.begin(), input.end(), data_ + size_);
+            size_ += input.size();
+        }
+
+    private:
+        static constexpr std::size_t INLINE_SIZE = 2 * sizeof(void *);
+
+        template<typename Alloc>
+        using ByteAllocOf = typename std::allocator_traits<
+            Alloc>::template rebind_alloc<std::byte>;
+        template<typename ByteAlloc>
+        using HolderAllocOf = typename std::allocator_traits<
+            ByteAlloc>::template rebind_alloc<ByteAlloc>;
+
+        template<typename ByteAlloc>
+        static constexpr bool fitsInline()
+        {
+            return sizeof(ByteAlloc) <= INLINE_SIZE &&
+                   alignof(ByteAlloc) <= alignof(void *);
+        }
+
+        template<typename ByteAlloc>
+        static std::byte *allocateWith(void *const alloc,
+                                       const std::size_t size)
+        {
+            return std::allocator_traits<ByteAlloc>::allocate(
+                *static_cast<ByteAlloc *>(alloc), size);
+        }
+
+        template<typename ByteAlloc>
+        static void deallocateWith(void *const alloc, std::byte *const ptr,
+                                   const std::size_t size)
+        {
+            std::allocator_traits<ByteAlloc>::deallocate(
+                *static_cast<ByteAlloc *>(alloc), ptr, size);
+        }
+
+        template<typename ByteAlloc>
+        static void release(void *const ptr)
+        {
+            auto *const alloc = static_cast<ByteAlloc *>(ptr);
+            if constexpr(fitsInline<ByteAlloc>())
+            {
+                alloc->~ByteAlloc();
+            }
+            else
+            {
+                HolderAllocOf<ByteAlloc> holderAlloc(*alloc);
+                alloc->~ByteAlloc();
+                std::allocator_traits<HolderAllocOf<ByteAlloc>>::deallocate(
+                    holderAlloc, alloc, 1);
+            }
+        }
+
+        template<typename ByteAlloc>
+        static constexpr Ops OPS{&allocateWith<ByteAlloc>,
+                                 &deallocateWith<ByteAlloc>,
+                                 &release<ByteAlloc>};
+
+        const Ops *ops_;
+        void *alloc_ = nullptr;
+        std::byte *data_ = nullptr;
+        std::size_t size_ = 0;
+        std::size_t capacity_ = 0;
+        alignas(void *) std::byte storage_[INLINE_SIZE];
+    };
+}
+
+// Incremental parser of a byte stream. The parser coroutine awaits need(n)
+// and gets a view of the next n bytes, when they haven't arrived yet it is
+// suspended until enough chunks are fed. Parse state lives in the coroutine
+// frame, nothing is parsed twice. Bytes are only copied when a need spans
+// chunks.
+//
+// The view from need(n) points into the fed chunk or the carry buffer, so
+// it is only valid until the next co_await or the end of the feed() call
+// that resumed the coroutine. Values needed later are read or copied out
+// before that. A moved-from parser is done and consumes nothing.
+//
+// Frames and the carry buffer are allocated with the allocator passed after
+// std::allocator_arg as the first coroutine parameters, or with
+// std::allocator otherwise.
+template<typename Result>
+class Parser
+{
+public:
+    class promise_type
+    {
+        friend class Parser;
+
+        struct Awaiter
+        {
+            promise_type *promise;
+            std::size_t size;
+
+            bool await_ready() const
+            {
+                return promise->take(size);
+            }
+            void await_suspend(std::coroutine_handle<>) const
+            {
+            }
+            Unformatter<const std::byte, DynamicSize> await_resume() const
+            {
+                return Unformatter<const std::byte, DynamicSize>(
+                    promise->view_);
+            }
+        };
+
+    public:
+        promise_type() : buffer_(std::allocator<std::byte>{})
+        {
+        }
+        template<typename Alloc, typename... Args>
+        promise_type(std::allocator_arg_t, const Alloc &alloc, const Args &...)
+            : buffer_(alloc)
+        {
+        }
+
+        static void *operator new(const std::size_t size)
+        {
+            return inner::ParserFrame::allocate(size,
+                                                std::allocator<std::byte>{});
+        }
+        template<typename Alloc, typename... Args>
+        static void *operator new(const std::size_t size, std::allocator_arg_t,
+                                  const Alloc &alloc, const Args &...)
+        {
+            return inner::ParserFrame::allocate(size, alloc);
+        }
+        static void operator delete(void *const ptr, const std::size_t size)
+        {
+            inner::ParserFrame::free(ptr, size);
+        }
+
+        Parser get_return_object()
+        {
+            return Parser(
+                std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() const noexcept
+        {
+            return {};
+        }
+        std::suspend_always final_suspend() const noexcept
+        {
+            return {};
+        }
+        void return_value(Result value)
+        {
+            result_ = std::move(value);
+        }
+        void unhandled_exception() const
+        {
+            std::terminate();
+        }
+
+        Awaiter await_transform(const Need need)
+        {
+            return Awaiter{this, need.size};
+        }
+
+    private:
+        bool take(const std::size_t size)
+        {
+            if(carried_)
+            {
+                buffer_.clear();
+                carried_ = false;
+            }
+            if(buffer_.empty() && input_.size() >= size)
+            {
+                view_ = input_.first(size);
+                input_ = input_.subspan(size);
+                return true;
+            }
+            needed_ = size;
+            return topUp();
+        }
+
+        bool topUp()
+        {
+            const auto count =
+                std::min(needed_ - buffer_.size(), input_.size());
+            buffer_.append(input_.first(count));
+            input_ = input_.subspan(count);
+            if(buffer_.size() < needed_)
+            {
+                return false;
+            }
+            view_ = buffer_.bytes();
+            carried_ = true;
+            return true;
+        }
+
+        std::span<const std::byte> input_;
+        std::span<const std::byte> view_;
+        inner::ParserBuffer buffer_;
+        std::size_t needed_ = 0;
+        bool carried_ = false;
+        bool started_ = false;
+        std::optional<Result> result_;
+    };
+
+    Parser(const Parser &) = delete;
+    Parser &operator=(const Parser &) = delete;
+    Parser(Parser &&other) noexcept
+        : handle_(std::exchange(other.handle_, nullptr))
+    {
+    }
+    Parser &operator=(Parser &&other) noexcept
+    {
+        std::swap(handle_, other.handle_);
+        return *this;
+    }
+    ~Parser()
+    {
+        if(handle_)
+        {
+            handle_.destroy();
+        }
+    }
+
+    // Runs the parser over the chunk until it needs more bytes or finishes.
+    // Returns the number of consumed bytes, it is less than the chunk size
+    // only when the parser finished. The chunk isn't referenced after the
+    // call.
+    std::size_t feed(const std::span<const std::byte> chunk)
+    {
+        if(done())
+        {
+            return 0;
+        }
+        auto &promise = handle_.promise();
+        promise.input_ = chunk;
+        if(!promise.started_)
+        {
+            promise.started_ = true;
+            handle_.resume();
+        }
+        else if(promise.topUp())
+        {
+            handle_.resume();
+        }
+        const auto consumed = chunk.size() - promise.input_.size();
+        promise.input_ = {};
+        return consumed;
+    }
+
+    [[nodiscard]] bool done() const
+    {
+        return !handle_ || handle_.done();
+    }
+
+    // Set once the parser finished, empty for a moved-from parser.
+    [[nodiscard]] const std::optional<Result> &result() const
+    {
+        static const std::optional<Result> NONE;
+        return handle_ ? handle_.promise().result_ : NONE;
+    }
+
+private:
+    explicit Parser(const std::coroutine_handle<promise_type> handle)
+        : handle_(handle)
+    {
+    }
+
+    std::coroutine_handle<promise_type> handle_;
+};
+}
+
+#endif
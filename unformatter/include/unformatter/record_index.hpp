@@ -0,0 +1,406 @@
+#ifndef UNFORMATTER_RECORD_INDEX_HPP
+#define UNFORMATTER_RECORD_INDEX_HPP
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "unformatter/check.hpp"
+#include "unformatter/unformatter.hpp"
+
+namespace unformatter
+{
+struct RecordIndexOptions
+{
+    // Worker threads of the build, 0 uses the hardware concurrency.
+    std::size_t threads = 0;
+    // Files are split into chunks of at least this size, one per thread.
+    std::size_t minChunkSize = std::size_t{1} << 16;
+    // Longest payload expected. Speculative walks only start where this
+    // many records in a row have plausible lengths, payload bytes read as
+    // a length rarely do. Longer records are still indexed, the bound only
+    // steers the speculation.
+    std::uint64_t maxLength = std::numeric_limits<std::uint64_t>::max();
+    std::size_t validateRecords = 4;
+};
+
+// How much of the speculative work a build kept.
+struct RecordIndexBuildReport
+{
+    std::size_t chunks = 0;
+    // Chunks after the first whose speculative walk the real chain met.
+    std::size_t adoptedChunks = 0;
+    // Records the real chain walked serially before meeting a walk.
+    std::size_t serialRecords = 0;
+};
+
+// Offsets of the records of a file of records prefixed by their payload
+// length, an L in Endian byte order. Every CHECKPOINT_INTERVAL records the
+// full offset is kept as a checkpoint, the other records keep a 32-bit delta
+// from their checkpoint, so record k is found in O(1).
+//
+// The build walks the file in parallel chunks. Every chunk after the first
+// is walked speculatively from the first offset where validateRecords
+// records in a row have lengths up to maxLength and fit in the file, which
+// is a real record start unless the payloads mimic records. Then the real
+// record chain entering the chunk is followed until it reaches an offset of
+// the speculative walk. From there both chains are the same and the rest of
+// the walk is kept, otherwise the chunk is walked again.
+template<std::unsigned_integral L, std::endian Endian = std::endian::native>
+class RecordIndex
+{
+    using MutableFile = Unformatter<std::byte, DynamicSize>;
+
+    static constexpr std::size_t PREFIX_SIZE = sizeof(L);
+    static constexpr std::string_view MAGIC = "UFRI";
+    static constexpr std::size_t HEADER_SIZE = 24;
+
+public:
+    using File = Unformatter<const std::byte, DynamicSize>;
+
+    static constexpr std::size_t CHECKPOINT_INTERVAL = 64;
+
+    // Fails on a truncated record, or when the records of one checkpoint
+    // interval span 4 GiB or more.
+    [[nodiscard]] static std::optional<RecordIndex> build(
+        const File &file, const RecordIndexOptions &options = {})
+    {
+        RecordIndexBuildReport report;
+        return build(file, options, report);
+    }
+    [[nodiscard]] static std::optional<RecordIndex> build(
+        const File &file, const RecordIndexOptions &options,
+        RecordIndexBuildReport &report)
+    {
+        const auto size = (*file).size();
+        const auto threads = std::max<std::size_t>(
+            1, std::min(options.threads != 0
+                            ? options.threads
+                            : std::thread::hardware_concurrency(),
+                        size / std::max<std::size_t>(options.minChunkSize, 1)));
+        std::vector<Walk> walks(threads);
+        {
+            std::vector<std::jthread> workers;
+            workers.reserve(threads - 1);
+            for(std::size_t idx = 1; idx < threads; ++idx)
+            {
+                workers.emplace_back(
+                    [&file, &walks, &options, idx, size, threads] {
+                        walks[idx] = speculate(
+                            file, chunkStart(idx, size, threads),
+                            chunkStart(idx + 1, size, threads), options);
+                    });
+            }
+            walks[0] = walk(file, 0, chunkStart(1, size, threads));
+        }
+
+        // The first chunk is walked from the real start.
+        auto offsets = std::move(walks[0].offsets);
+        auto entry = walks[0].exit;
+        report = RecordIndexBuildReport{threads, 0, 0};
+        for(std::size_t idx = 1; idx < threads && entry; ++idx)
+        {
+            entry = resync(file, walks[idx], *entry,
+                           chunkStart(idx + 1, size, threads), offsets,
+                           report);
+        }
+        if(!entry)
+        {
+            return std::nullopt;
+        }
+        return encode(offsets, size);
+    }
+
+    // Index saved by save for the file, nullopt when it doesn't match the
+    // record format or the file size.
+    [[nodiscard]] static std::optional<RecordIndex> load(const File &saved,
+                                                         const File &file)
+    {
+        const auto header = saved.subs(0, HEADER_SIZE);
+        if(!header ||
+           !std::ranges::equal(
+               *header->subsUnchecked(0, MAGIC.size()), MAGIC,
+               [](const std::byte left, const char right) {
+                   return left == static_cast<std::byte>(right);
+               }) ||
+           header->subsUnchecked(4, 1).readUnchecked<std::uint8_t>() !=
+               PREFIX_SIZE ||
+           header->subsUnchecked(5, 1).readUnchecked<std::uint8_t>() !=
+               static_cast<std::uint8_t>(Endian == std::endian::big) ||
+           readLittle<std::uint16_t>(*header, 6) != CHECKPOINT_INTERVAL ||
+           readLittle<std::uint64_t>(*header, 16) != (*file).size())
+        {
+            return std::nullopt;
+        }
+        const auto count = readLittle<std::uint64_t>(*header, 8);
+        const auto checkpoints = checkpointCount(count);
+        if(count > ((*saved).size() - HEADER_SIZE) / sizeof(std::uint32_t) ||
+           (*saved).size() != savedSize(count))
+        {
+            return std::nullopt;
+        }
+        RecordIndex index(static_cast<std::size_t>(count), (*file).size());
+        auto pos = HEADER_SIZE;
+        for(std::size_t idx = 0; idx < checkpoints; ++idx)
+        {
+            index.checkpoints_[idx] = readLittle<std::uint64_t>(saved, pos);
+            pos += sizeof(std::uint64_t);
+        }
+        for(auto &delta : index.deltas_)
+        {
+            delta = readLittle<std::uint32_t>(saved, pos);
+            pos += sizeof(std::uint32_t);
+        }
+        return index;
+    }
+
+    // Little endian header, checkpoints and deltas, to keep next to the file.
+    [[nodiscard]] std::vector<std::byte> save() const
+    {
+        std::vector<std::byte> saved(savedSize(deltas_.size()));
+        const MutableFile savedUnfmt(saved);
+        for(std::size_t idx = 0; idx < MAGIC.size(); ++idx)
+        {
+            saved[idx] = static_cast<std::byte>(MAGIC[idx]);
+        }
+        savedUnfmt.subsUnchecked(4, 1).writeUnchecked(
+            static_cast<std::uint8_t>(PREFIX_SIZE));
+        savedUnfmt.subsUnchecked(5, 1).writeUnchecked(
+            static_cast<std::uint8_t>(Endian == std::endian::big));
+        writeLittle(savedUnfmt, 6,
+                    static_cast<std::uint16_t>(CHECKPOINT_INTERVAL));
+        writeLittle(savedUnfmt, 8, static_cast<std::uint64_t>(deltas_.size()));
+        writeLittle(savedUnfmt, 16, static_cast<std::uint64_t>(fileSize_));
+        auto pos = HEADER_SIZE;
+        for(const auto checkpoint : checkpoints_)
+        {
+            writeLittle(savedUnfmt, pos, checkpoint);
+            pos += sizeof(std::uint64_t);
+        }
+        for(const auto delta : deltas_)
+        {
+            writeLittle(savedUnfmt, pos, delta);
+            pos += sizeof(std::uint32_t);
+        }
+        return saved;
+    }
+
+    [[nodiscard]] std::size_t size() const
+    {
+        return deltas_.size();
+    }
+
+    // Offset of the length prefix of the record, which must be below
+    // size(). The policy checks it like the unchecked accessors.
+    template<CheckPolicy Check = DebugChecked>
+    [[nodiscard]] std::size_t offset(const std::size_t record) const
+    {
+        Check::check(record < size());
+        return static_cast<std::size_t>(
+            checkpoints_[record / CHECKPOINT_INTERVAL] + deltas_[record]);
+    }
+
+    // Payload of the record in the indexed file, nullopt for another file.
+    [[nodiscard]] std::optional<File> record(const File &file,
+                                             const std::size_t record) const
+    {
+        if(record >= size() || (*file).size() != fileSize_)
+        {
+            return std::nullopt;
+        }
+        const auto start = offset(record) + PREFIX_SIZE;
+        const auto end =
+            record + 1 < size() ? offset(record + 1) : fileSize_;
+        return file.subs(start, end - start);
+    }
+
+private:
+    // Record offsets from a start up to a chunk end, and the offset after
+    // the last record, nullopt when a record overruns the file.
+    struct Walk
+    {
+        std::vector<std::size_t> offsets;
+        std::optional<std::size_t> exit;
+    };
+
+    RecordIndex(const std::size_t count, const std::size_t fileSize)
+        : checkpoints_(checkpointCount(count)), deltas_(count),
+          fileSize_(fileSize)
+    {
+    }
+
+    static constexpr std::size_t checkpointCount(const std::uint64_t count)
+    {
+        return static_cast<std::size_t>(
+            (count + CHECKPOINT_INTERVAL - 1) / CHECKPOINT_INTERVAL);
+    }
+
+    static constexpr std::size_t savedSize(const std::uint64_t count)
+    {
+        return HEADER_SIZE + checkpointCount(count) * sizeof(std::uint64_t) +
+               static_cast<std::size_t>(count) * sizeof(std::uint32_t);
+    }
+
+    static constexpr std::size_t chunkStart(const std::size_t chunk,
+                                            const std::size_t size,
+                                            const std::size_t chunks)
+    {
+        return chunk == chunks ? size : size / chunks * chunk;
+    }
+
+    // Offset after the record at offset, nullopt when it overruns the file
+    // or its length exceeds maxLength.
+    static std::optional<std::size_t> next(
+        const File &file, const std::size_t offset,
+        const std::uint64_t maxLength =
+            std::numeric_limits<std::uint64_t>::max())
+    {
+        const auto size = (*file).size();
+        if(size - offset < PREFIX_SIZE)
+        {
+            return std::nullopt;
+        }
+        const auto length =
+            file.subsUnchecked<Unchecked>(offset, PREFIX_SIZE)
+                .template readUnchecked<L, Endian, Unchecked>();
+        if(size - offset - PREFIX_SIZE < length ||
+           static_cast<std::uint64_t>(length) > maxLength)
+        {
+            return std::nullopt;
+        }
+        return offset + PREFIX_SIZE + static_cast<std::size_t>(length);
+    }
+
+    static Walk walk(const File &file, const std::size_t start,
+                     const std::size_t end)
+    {
+        Walk result{{}, start};
+        while(result.exit && *result.exit < end)
+        {
+            result.offsets.push_back(*result.exit);
+            result.exit = next(file, *result.exit);
+        }
+        return result;
+    }
+
+    // Whether validateRecords records in a row from offset are plausible.
+    // Records ending exactly at the end of the file count as plausible.
+    static bool plausible(const File &file, std::size_t offset,
+                          const RecordIndexOptions &options)
+    {
+        for(std::size_t count = 0;
+            count < options.validateRecords && offset < (*file).size();
+            ++count)
+        {
+            const auto following = next(file, offset, options.maxLength);
+            if(!following)
+            {
+                return false;
+            }
+            offset = *following;
+        }
+        return true;
+    }
+
+    // Walk from the first plausible offset of the chunk, an empty walk when
+    // there is none.
+    static Walk speculate(const File &file, const std::size_t start,
+                          const std::size_t end,
+                          const RecordIndexOptions &options)
+    {
+        for(auto pos = start; pos < end; ++pos)
+        {
+            if(plausible(file, pos, options))
+            {
+                return walk(file, pos, end);
+            }
+        }
+        return Walk{{}, std::nullopt};
+    }
+
+    // Follows the real chain from entry through the chunk, adopting the
+    // speculative walk once the chains meet. Returns the entry of the next
+    // chunk.
+    static std::optional<std::size_t> resync(const File &file,
+                                             const Walk &speculative,
+                                             std::size_t entry,
+                                             const std::size_t end,
+                                             std::vector<std::size_t> &offsets,
+                                             RecordIndexBuildReport &report)
+    {
+        auto candidate = speculative.offsets.begin();
+        while(entry < end)
+        {
+            candidate =
+                std::lower_bound(candidate, speculative.offsets.end(), entry);
+            if(candidate != speculative.offsets.end() && *candidate == entry)
+            {
+                ++report.adoptedChunks;
+                offsets.insert(offsets.end(), candidate,
+                               speculative.offsets.end());
+                return speculative.exit;
+            }
+            offsets.push_back(entry);
+            ++report.serialRecords;
+            const auto maybeNext = next(file, entry);
+            if(!maybeNext)
+            {
+                return std::nullopt;
+            }
+            entry = *maybeNext;
+        }
+        return entry;
+    }
+
+    static std::optional<RecordIndex> encode(
+        const std::vector<std::size_t> &offsets, const std::size_t fileSize)
+    {
+        RecordIndex index(offsets.size(), fileSize);
+        for(std::size_t idx = 0; idx < offsets.size(); ++idx)
+        {
+            auto &checkpoint = index.checkpoints_[idx / CHECKPOINT_INTERVAL];
+            if(idx % CHECKPOINT_INTERVAL == 0)
+            {
+                checkpoint = offsets[idx];
+            }
+            const auto delta = offsets[idx] - checkpoint;
+            if(delta > std::numeric_limits<std::uint32_t>::max())
+            {
+                return std::nullopt;
+            }
+            index.deltas_[idx] = static_cast<std::uint32_t>(delta);
+        }
+        return index;
+    }
+
+    template<std::unsigned_integral V>
+    static V readLittle(const File &data, const std::size_t offset)
+    {
+        return data.subsUnchecked(offset, sizeof(V))
+            .template readUnchecked<V, std::endian::little>();
+    }
+
+    template<std::unsigned_integral V>
+    static void writeLittle(const MutableFile &data, const std::size_t offset,
+                            const V val)
+    {
+        data.subsUnchecked(offset, sizeof(V))
+            .template writeUnchecked<std::endian::little>(val);
+    }
+
+    std::vector<std::uint64_t> checkpoints_;
+    std::vector<std::uint32_t> deltas_;
+    std::size_t fileSize_;
+};
+}
+
+#endif
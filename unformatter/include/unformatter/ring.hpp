@@ -0,0 +1,306 @@
+#ifndef UNFORMATTER_RING_HPP
+#define UNFORMATTER_RING_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "unformatter/inner/common.hpp"
+#include "unformatter/size.hpp"
+#include "unformatter/stats.hpp"
+#include "unformatter/unformatter.hpp"
+
+namespace unformatter
+{
+// Region of a power of two circular byte buffer that may wrap around its
+// end. The region is kept as the part up to the buffer end and the part
+// from the buffer start, accesses that fall into one part use it directly.
+template<typename T>
+requires(std::is_trivial_v<T> && sizeof(T) == 1)
+class RingRegion
+{
+public:
+    // Head is a free running position, it is wrapped by the ring size.
+    [[nodiscard]] static constexpr std::optional<RingRegion> create(
+        const std::span<T> ring, const std::size_t head, const std::size_t size)
+    {
+        if(!std::has_single_bit(ring.size()) || size > ring.size())
+        {
+            stats::Policy::boundsFailure(stats::Site::create);
+            return std::nullopt;
+        }
+        const auto start = head & (ring.size() - 1);
+        const auto firstSize = std::min(size, ring.size() - start);
+        return RingRegion(ring.subspan(start, firstSize),
+                          ring.first(size - firstSize));
+    }
+
+    [[nodiscard]] constexpr std::size_t size() const
+    {
+        return first_.size() + second_.size();
+    }
+
+    [[nodiscard]] constexpr bool isWrapped() const
+    {
+        return !second_.empty();
+    }
+
+    // The region as a plain unformatter when it doesn't wrap.
+    [[nodiscard]] constexpr std::optional<Unformatter<T, DynamicSize>>
+    contiguous() const
+    {
+        if(isWrapped())
+        {
+            return std::nullopt;
+        }
+        return Unformatter<T, DynamicSize>(first_);
+    }
+
+    [[nodiscard]] constexpr std::optional<RingRegion> subs(
+        const std::size_t offset,
+        const std::optional<std::size_t> maybeSize = {}) const
+    {
+        const auto maybeSubsSize =
+            inner::common::subsSize(offset, maybeSize, size());
+        if(!maybeSubsSize)
+        {
+            stats::Policy::boundsFailure(stats::Site::subs);
+            return std::nullopt;
+        }
+        if(offset >= first_.size())
+        {
+            return RingRegion(
+                second_.subspan(offset - first_.size(), *maybeSubsSize), {});
+        }
+        const auto firstSize =
+            std::min(*maybeSubsSize, first_.size() - offset);
+        return RingRegion(first_.subspan(offset, firstSize),
+                          second_.first(*maybeSubsSize - firstSize));
+    }
+
+    template<typename V, std::endian Endian = std::endian::native>
+    [[nodiscard]] constexpr std::optional<V> read() const
+    {
+        if(!isWrapped())
+        {
+            return Unformatter<T, DynamicSize>(first_)
+                .template read<V, Endian>();
+        }
+        if(size() != sizeof(V))
+        {
+            stats::Policy::boundsFailure(stats::Site::read);
+            return std::nullopt;
+        }
+        std::array<std::remove_const_t<T>, sizeof(V)> buf{};
+        std::ranges::copy(second_,
+                          std::ranges::copy(first_, buf.begin()).out);
+        return Unformatter<const std::remove_const_t<T>, DynamicSize>(buf)
+            .template read<V, Endian>();
+    }
+
+    template<std::endian Endian = std::endian::native, typename V>
+    [[nodiscard]] constexpr bool write(const V val) const
+    {
+        if(!isWrapped())
+        {
+            return Unformatter<T, DynamicSize>(first_).template write<Endian>(
+                val);
+        }
+        if(size() != sizeof(V))
+        {
+            stats::Policy::boundsFailure(stats::Site::write);
+            return false;
+        }
+        std::array<T, sizeof(V)> buf{};
+        [[maybe_unused]] const auto res =
+            Unformatter<T, DynamicSize>(buf).template write<Endian>(val);
+        const auto split = buf.begin() + first_.size();
+        std::ranges::copy(buf.begin(), split, first_.begin());
+        std::ranges::copy(split, buf.end(), second_.begin());
+        return true;
+    }
+
+    // Elements of other that fit in one part are copied in bulk, only the
+    // element crossing the buffer end is assembled separately.
+    template<std::endian Endian = std::endian::native, typename V,
+             std::size_t OtherExtent>
+    [[nodiscard]] constexpr bool readCollection(
+        const inner::UnformatterBase<V, OtherExtent> &other) const
+    {
+        if(size() != other.size() * sizeof(V))
+        {
+            stats::Policy::boundsFailure(stats::Site::readCollection);
+            return false;
+        }
+        const auto headCount = first_.size() / sizeof(V);
+        [[maybe_unused]] auto res =
+            Unformatter<T, DynamicSize>(first_.first(headCount * sizeof(V)))
+                .template readCollection<Endian>(*other.subs(0, headCount));
+        if(headCount < other.size())
+        {
+            res = other.subs(headCount, 1)->write(
+                *subs(headCount * sizeof(V), sizeof(V))
+                     ->template read<V, Endian>());
+            const auto tail = *subs((headCount + 1) * sizeof(V));
+            res = Unformatter<T, DynamicSize>(tail.first_)
+                      .template readCollection<Endian>(
+                          *other.subs(headCount + 1));
+        }
+        return true;
+    }
+
+    template<std::endian Endian = std::endian::native, typename V,
+             std::size_t OtherExtent>
+    [[nodiscard]] constexpr bool writeCollection(
+        const inner::UnformatterBase<V, OtherExtent> &other) const
+    {
+        if(size() != other.size() * sizeof(V))
+        {
+            stats::Policy::boundsFailure(stats::Site::writeCollection);
+            return false;
+        }
+        const auto headCount = first_.size() / sizeof(V);
+        [[maybe_unused]] auto res =
+            Unformatter<T, DynamicSize>(first_.first(headCount * sizeof(V)))
+                .template writeCollection<Endian>(*other.subs(0, headCount));
+        if(headCount < other.size())
+        {
+            res = subs(headCount * sizeof(V), sizeof(V))
+                      ->template write<Endian>(
+                          *other.subs(headCount, 1)
+                               ->template read<std::remove_const_t<V>>());
+            const auto tail = *subs((headCount + 1) * sizeof(V));
+            res = Unformatter<T, DynamicSize>(tail.first_)
+                      .template writeCollection<Endian>(
+                          *other.subs(headCount + 1));
+        }
+        return true;
+    }
+
+private:
+    constexpr RingRegion(const std::span<T> first, const std::span<T> second)
+        : first_(first), second_(second)
+    {
+    }
+
+    std::span<T> first_;
+    std::span<T> second_;
+};
+
+#if defined(__linux__)
+// Ring mapped twice back to back, so every region up to the ring size is
+// contiguous in memory and needs no wrap handling.
+class MirroredRing
+{
+public:
+    // Size must be a power of two multiple of the page size.
+    [[nodiscard]] static std::optional<MirroredRing> create(
+        const std::size_t size)
+    {
+        const auto pageSize =
+            static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        if(!std::has_single_bit(size) || size % pageSize != 0)
+        {
+            return std::nullopt;
+        }
+        const auto fd = ::memfd_create("unformatter_ring", MFD_CLOEXEC);
+        if(fd < 0)
+        {
+            return std::nullopt;
+        }
+        std::optional<MirroredRing> result;
+        if(::ftruncate(fd, static_cast<off_t>(size)) == 0)
+        {
+            if(auto *const base = ::mmap(nullptr, 2 * size, PROT_NONE,
+                                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+               base != MAP_FAILED)
+            {
+                auto *const data = static_cast<std::byte *>(base);
+                if(mapHalf(data, size, fd) && mapHalf(data + size, size, fd))
+                {
+                    result = MirroredRing(data, size);
+                }
+                else
+                {
+                    ::munmap(base, 2 * size);
+                }
+            }
+        }
+        ::close(fd);
+        return result;
+    }
+
+    MirroredRing(const MirroredRing &) = delete;
+    MirroredRing &operator=(const MirroredRing &) = delete;
+    MirroredRing(MirroredRing &&other) noexcept
+        : data_(std::exchange(other.data_, nullptr)),
+          size_(std::exchange(other.size_, 0))
+    {
+    }
+    MirroredRing &operator=(MirroredRing &&other) noexcept
+    {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        return *this;
+    }
+    ~MirroredRing()
+    {
+        if(data_)
+        {
+            ::munmap(data_, 2 * size_);
+        }
+    }
+
+    [[nodiscard]] std::size_t size() const
+    {
+        return size_;
+    }
+
+    [[nodiscard]] std::span<std::byte> ring() const
+    {
+        return {data_, size_};
+    }
+
+    // Head is a free running position, it is wrapped by the ring size.
+    [[nodiscard]] std::optional<Unformatter<std::byte, DynamicSize>> region(
+        const std::size_t head, const std::size_t regionSize) const
+    {
+        if(regionSize > size_)
+        {
+            stats::Policy::boundsFailure(stats::Site::create);
+            return std::nullopt;
+        }
+        return Unformatter<std::byte, DynamicSize>(
+            std::span<std::byte>(data_ + (head & (size_ - 1)), regionSize));
+    }
+
+private:
+    MirroredRing(std::byte *const data, const std::size_t size)
+        : data_(data), size_(size)
+    {
+    }
+
+    static bool mapHalf(std::byte *const addr, const std::size_t size,
+                        const int fd)
+    {
+        return ::mmap(addr, size, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED;
+    }
+
+    std::byte *data_;
+    std::size_t size_;
+};
+#endif
+}
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef UNFORMATTER_SIZE_HPP
 #define UNFORMATTER_SIZE_HPP
 
+#include <bit>
 #include <concepts>
 #include <cstddef>
 
@@ -11,14 +12,17 @@ namespace unformatter
 struct DynamicSize
 {
 };
-template<std::size_t Start, std::size_t Size>
+// Alignment is the guaranteed byte alignment of the range start.
+template<std::size_t Start, std::size_t Size, std::size_t Alignment = 1>
+requires(std::has_single_bit(Alignment))
 struct RangeSize
 {
     static constexpr auto start = Start;
     static constexpr auto size = Size;
+    static constexpr auto alignment = Alignment;
 };
-template<std::size_t Size>
-using StaticSize = RangeSize<Size, 1>;
+template<std::size_t Size, std::size_t Alignment = 1>
+using StaticSize = RangeSize<Size, 1, Alignment>;
 
 template<typename S>
 concept SizeType = std::same_as<S, DynamicSize> ||
@@ -0,0 +1,157 @@
+#ifndef UNFORMATTER_STATS_HPP
+#define UNFORMATTER_STATS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// The policy is chosen by UNFORMATTER_STATS and UNFORMATTER_STATS_POLICY,
+// which must be set the same way for every translation unit of a program,
+// on the compiler command line rather than before an include. The library
+// functions are inline templates calling the policy, so translation units
+// built with different settings break the one definition rule and the
+// linker keeps one of the definitions silently. MSVC reports the mismatch
+// at link time.
+namespace unformatter::stats
+{
+// Bounds check failures are counted per API entry point, not per call site:
+// all failing reads of a program add to Site::read.
+enum class Site : std::size_t
+{
+    create,
+    subs,
+    split,
+    read,
+    write,
+    readCollection,
+    writeCollection,
+    bitSubs,
+    bitReadCollection,
+    bitWriteCollection,
+    bitWriteRepr,
+    readStruct,
+    writeStruct,
+    encode,
+    decode,
+};
+inline constexpr std::size_t SITE_COUNT =
+    static_cast<std::size_t>(Site::decode) + 1;
+
+struct Counters
+{
+    std::array<std::uint64_t, SITE_COUNT> boundsFailures{};
+    std::uint64_t byteCopies = 0;
+    std::uint64_t bytesCopied = 0;
+    std::uint64_t endianSwaps = 0;
+    std::uint64_t bitCopies = 0;
+    std::uint64_t bitsCopied = 0;
+    std::uint64_t unalignedBitCopies = 0;
+
+    [[nodiscard]]
+    constexpr std::uint64_t boundsFailure(const Site site) const
+    {
+        return boundsFailures[static_cast<std::size_t>(site)];
+    }
+};
+
+// Default policy, every hook is empty and compiles away.
+struct NoStats
+{
+    static constexpr void boundsFailure(Site)
+    {
+    }
+    static constexpr void bytesCopied(std::size_t, std::size_t)
+    {
+    }
+    static constexpr void bitsCopied(std::size_t, bool)
+    {
+    }
+
+    static Counters snapshot()
+    {
+        return {};
+    }
+    static void reset()
+    {
+    }
+};
+
+// Counts into thread local counters, so hooks stay uncontended.
+struct ThreadLocalStats
+{
+    static constexpr void boundsFailure(const Site site)
+    {
+        if(!std::is_constant_evaluated())
+        {
+            ++counters().boundsFailures[static_cast<std::size_t>(site)];
+        }
+    }
+    static constexpr void bytesCopied(const std::size_t size,
+                                      const std::size_t swaps)
+    {
+        if(!std::is_constant_evaluated())
+        {
+            auto &cur = counters();
+            ++cur.byteCopies;
+            cur.bytesCopied += size;
+            cur.endianSwaps += swaps;
+        }
+    }
+    static constexpr void bitsCopied(const std::size_t size,
+                                     const bool unaligned)
+    {
+        if(!std::is_constant_evaluated())
+        {
+            auto &cur = counters();
+            ++cur.bitCopies;
+            cur.bitsCopied += size;
+            cur.unalignedBitCopies += unaligned;
+        }
+    }
+
+    static Counters snapshot()
+    {
+        return counters();
+    }
+    static void reset()
+    {
+        counters() = {};
+    }
+
+private:
+    static Counters &counters()
+    {
+        thread_local Counters cur;
+        return cur;
+    }
+};
+
+#if defined(UNFORMATTER_STATS_POLICY)
+using Policy = UNFORMATTER_STATS_POLICY;
+#if defined(_MSC_VER)
+#pragma detect_mismatch("unformatter_stats", "custom")
+#endif
+#elif defined(UNFORMATTER_STATS)
+using Policy = ThreadLocalStats;
+#if defined(_MSC_VER)
+#pragma detect_mismatch("unformatter_stats", "thread_local")
+#endif
+#else
+using Policy = NoStats;
+#if defined(_MSC_VER)
+#pragma detect_mismatch("unformatter_stats", "none")
+#endif
+#endif
+
+inline Counters snapshot()
+{
+    return Policy::snapshot();
+}
+inline void reset()
+{
+    Policy::reset();
+}
+}
+
+#endif
@@ -0,0 +1,291 @@
+#ifndef UNFORMATTER_STRUCT_HPP
+#define UNFORMATTER_STRUCT_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <type_traits>
+
+#include "unformatter/inner/common.hpp"
+#include "unformatter/size.hpp"
+#include "unformatter/stats.hpp"
+#include "unformatter/unformatter.hpp"
+
+namespace unformatter
+{
+namespace inner
+{
+    template<typename M>
+    struct MemberPointer
+    {
+    };
+    template<typename S, typename V>
+    struct MemberPointer<V S::*>
+    {
+        using Struct = S;
+        using Value = V;
+    };
+
+    // Values are swapped per element, so arrays of words keep their order.
+    template<typename V>
+    struct SwapChunk
+    {
+        static constexpr std::size_t SIZE = sizeof(V);
+    };
+    template<typename V, std::size_t Size>
+    struct SwapChunk<V[Size]>
+    {
+        static constexpr std::size_t SIZE = SwapChunk<V>::SIZE;
+    };
+    template<typename V, std::size_t Size>
+    struct SwapChunk<std::array<V, Size>>
+    {
+        static constexpr std::size_t SIZE = SwapChunk<V>::SIZE;
+    };
+}
+
+// Member of S stored at the byte Offset of the region with Endian byte order.
+template<auto Member, std::size_t Offset,
+         std::endian Endian = std::endian::native>
+requires std::is_member_object_pointer_v<decltype(Member)> &&
+         std::is_trivially_copyable_v<
+             typename inner::MemberPointer<decltype(Member)>::Value>
+struct StructField
+{
+    using Struct = typename inner::MemberPointer<decltype(Member)>::Struct;
+    using Value = typename inner::MemberPointer<decltype(Member)>::Value;
+
+    static constexpr auto member = Member;
+    static constexpr auto offset = Offset;
+    static constexpr auto size = sizeof(Value);
+    static constexpr auto swapChunk =
+        inner::common::isNativeEndianness<Endian>()
+            ? std::size_t{1}
+            : inner::SwapChunk<Value>::SIZE;
+    static constexpr auto swaps = swapChunk == 1 ? 0 : size / swapChunk;
+};
+
+namespace inner
+{
+    template<typename F>
+    concept StructFieldType = requires {
+        typename F::Struct;
+        typename F::Value;
+        F::member;
+        F::offset;
+        F::swapChunk;
+    };
+
+    template<typename... Fields>
+    consteval std::size_t layoutSize()
+    {
+        return std::max({std::size_t{0}, (Fields::offset + Fields::size)...});
+    }
+
+    template<std::size_t Size, typename... Fields>
+    consteval std::array<std::size_t, Size> layoutCoverage()
+    {
+        std::array<std::size_t, Size> coverage{};
+        (
+            [&] {
+                for(auto idx = Fields::offset;
+                    idx < Fields::offset + Fields::size; ++idx)
+                {
+                    ++coverage[idx];
+                }
+            }(),
+            ...);
+        return coverage;
+    }
+}
+
+// Wire layout of the trivially copyable S. Field offsets are independent of
+// the member offsets in S, so both padded and packed layouts work. Fields
+// must not overlap.
+template<typename S, inner::StructFieldType... Fields>
+requires std::is_trivially_copyable_v<S> &&
+         std::is_default_constructible_v<S> &&
+         (std::same_as<S, typename Fields::Struct> && ...)
+struct StructLayout
+{
+    using Struct = S;
+
+    static constexpr std::size_t size = inner::layoutSize<Fields...>();
+    static constexpr std::size_t swaps =
+        (std::size_t{0} + ... + Fields::swaps);
+
+    static_assert(std::ranges::all_of(
+                      inner::layoutCoverage<size, Fields...>(),
+                      [](const auto cnt) { return cnt <= 1; }),
+                  "struct fields overlap");
+
+    // Bytes not covered by any field are kept on write.
+    static constexpr bool covering =
+        std::ranges::all_of(inner::layoutCoverage<size, Fields...>(),
+                            [](const auto cnt) { return cnt == 1; });
+
+    using Bytes = std::array<std::byte, size>;
+
+    static constexpr S load(const Bytes &bytes)
+    {
+        S result{};
+        (loadField<Fields>(result, bytes), ...);
+        return result;
+    }
+
+    static constexpr void store(Bytes &bytes, const S &value)
+    {
+        (storeField<Fields>(bytes, value), ...);
+    }
+
+private:
+    template<typename F>
+    static constexpr void loadField(S &result, const Bytes &bytes)
+    {
+        std::array<std::byte, F::size> raw{};
+        std::copy_n(bytes.begin() + F::offset, F::size, raw.begin());
+        raw = inner::common::swapChunks<F::swapChunk>(raw);
+        auto &dst = result.*F::member;
+        if constexpr(std::is_array_v<typename F::Value>)
+        {
+            using Elems = std::array<std::remove_extent_t<typename F::Value>,
+                                     std::extent_v<typename F::Value>>;
+            std::ranges::copy(std::bit_cast<Elems>(raw), std::begin(dst));
+        }
+        else
+        {
+            dst = std::bit_cast<typename F::Value>(raw);
+        }
+    }
+
+    template<typename F>
+    static constexpr void storeField(Bytes &bytes, const S &value)
+    {
+        const auto &src = value.*F::member;
+        std::array<std::byte, F::size> raw{};
+        if constexpr(std::is_array_v<typename F::Value>)
+        {
+            using Elems = std::array<std::remove_extent_t<typename F::Value>,
+                                     std::extent_v<typename F::Value>>;
+            Elems elems{};
+            std::ranges::copy(src, elems.begin());
+            raw = std::bit_cast<decltype(raw)>(elems);
+        }
+        else
+        {
+            raw = std::bit_cast<decltype(raw)>(src);
+        }
+        raw = inner::common::swapChunks<F::swapChunk>(raw);
+        std::ranges::copy(raw, bytes.begin() + F::offset);
+    }
+};
+
+namespace inner
+{
+    template<typename L, typename T, std::size_t Extent>
+    constexpr typename L::Struct readStruct(const std::span<T, Extent> data)
+    {
+        typename L::Bytes bytes{};
+        stats::Policy::bytesCopied(L::size, L::swaps);
+        if(std::is_constant_evaluated())
+        {
+            for(std::size_t idx = 0; idx < L::size; ++idx)
+            {
+                bytes[idx] = inner::common::loadByte(data, idx);
+            }
+        }
+        else
+        {
+            std::copy_n(std::as_bytes(data).data(), L::size, bytes.data());
+        }
+        return L::load(bytes);
+    }
+
+    template<typename L, typename T, std::size_t Extent>
+    constexpr void writeStruct(const std::span<T, Extent> data,
+                               const typename L::Struct &value)
+    {
+        typename L::Bytes bytes{};
+        stats::Policy::bytesCopied(L::size, L::swaps);
+        if(std::is_constant_evaluated())
+        {
+            if constexpr(!L::covering)
+            {
+                for(std::size_t idx = 0; idx < L::size; ++idx)
+                {
+                    bytes[idx] = inner::common::loadByte(data, idx);
+                }
+            }
+            L::store(bytes, value);
+            for(std::size_t idx = 0; idx < L::size; ++idx)
+            {
+                inner::common::storeByte(data, idx, bytes[idx]);
+            }
+        }
+        else
+        {
+            const auto dst = std::as_writable_bytes(data);
+            if constexpr(!L::covering)
+            {
+                std::copy_n(dst.data(), L::size, bytes.data());
+            }
+            L::store(bytes, value);
+            std::copy_n(bytes.data(), L::size, dst.data());
+        }
+    }
+}
+
+// The region is copied once, then the non native fields are swapped.
+template<typename L, typename T, std::size_t RngStart, std::size_t RngSize,
+         std::size_t RngAlignment>
+requires(RngSize == 1 && inner::bufferSize<T, RngStart>() == L::size)
+[[nodiscard]] constexpr typename L::Struct readStruct(
+    const Unformatter<T, RangeSize<RngStart, RngSize, RngAlignment>>
+        &unformatter)
+{
+    return inner::readStruct<L>(*unformatter);
+}
+template<typename L, typename T>
+[[nodiscard]] constexpr std::optional<typename L::Struct> readStruct(
+    const Unformatter<T, DynamicSize> &unformatter)
+{
+    const auto data = *unformatter;
+    if(data.size_bytes() != L::size)
+    {
+        stats::Policy::boundsFailure(stats::Site::readStruct);
+        return std::nullopt;
+    }
+    return inner::readStruct<L>(data);
+}
+
+template<typename L, typename T, std::size_t RngStart, std::size_t RngSize,
+         std::size_t RngAlignment>
+requires(RngSize == 1 && inner::bufferSize<T, RngStart>() == L::size)
+constexpr void writeStruct(
+    const Unformatter<T, RangeSize<RngStart, RngSize, RngAlignment>>
+        &unformatter,
+    const typename L::Struct &value)
+{
+    inner::writeStruct<L>(*unformatter, value);
+}
+template<typename L, typename T>
+[[nodiscard]] constexpr bool writeStruct(
+    const Unformatter<T, DynamicSize> &unformatter,
+    const typename L::Struct &value)
+{
+    const auto data = *unformatter;
+    if(data.size_bytes() != L::size)
+    {
+        stats::Policy::boundsFailure(stats::Site::writeStruct);
+        return false;
+    }
+    inner::writeStruct<L>(data, value);
+    return true;
+}
+}
+
+#endif
@@ -2,12 +2,19 @@
 #define UNFORMATTER_UNFORMATTER_HPP
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <bit>
 #include <cassert>
 #include <charconv>
+#include <compare>
 #include <concepts>
 #include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
 #include <optional>
+#include <ranges>
 #include <span>
 #include <string_view>
 #include <system_error>
@@ -15,9 +22,12 @@
 #include <type_traits>
 
 #include "unformatter/bit.hpp"
+#include "unformatter/check.hpp"
 #include "unformatter/inner/common.hpp"
+#include "unformatter/inner/copy.hpp"
 #include "unformatter/inner/util.hpp"
 #include "unformatter/size.hpp"
+#include "unformatter/stats.hpp"
 
 namespace unformatter
 {
@@ -71,205 +81,527 @@ namespace inner
     {
         return val >= R::start && val - R::start < R::size;
     }
+
+    // Addresses can't be observed in constant evaluation, so there only
+    // the alignment of T is known and larger alignments fail. An object of
+    // static storage may be placed at any offset of an aligned parent.
+    template<std::size_t Alignment, typename T>
+    constexpr bool isAligned(const T *ptr)
+    {
+        if constexpr(Alignment <= alignof(T))
+        {
+            return true;
+        }
+        else
+        {
+            return !std::is_constant_evaluated() &&
+                   reinterpret_cast<std::uintptr_t>(ptr) % Alignment == 0;
+        }
+    }
+
+    // Writable field of exactly the size of V, aligned for a lock-free
+    // atomic_ref.
+    template<typename T, typename V, std::size_t Size, std::size_t Alignment>
+    concept AtomicField =
+        !std::is_const_v<T> && std::is_trivially_copyable_v<V> &&
+        sizeof(V) == Size &&
+        Alignment >= std::atomic_ref<V>::required_alignment &&
+        std::atomic_ref<V>::is_always_lock_free;
+
+    // Integer read from or written to a field of at most its size.
+    template<typename V, std::size_t Size>
+    concept ShortIntegerField = std::integral<V> && !std::same_as<V, bool> &&
+                                Size > 0 && Size <= sizeof(V);
+
+    template<std::size_t Alignment, std::size_t Offset>
+    consteval std::size_t subsAlignment()
+    {
+        if constexpr(Offset == 0)
+        {
+            return Alignment;
+        }
+        else
+        {
+            return std::min(Alignment, Offset & (~Offset + 1));
+        }
+    }
 }
 
 template<typename T, SizeType S>
 class Unformatter;
 
-template<typename T>
-class Unformatter<T, DynamicSize>
-{
-    template<typename, SizeType>
-    friend class Unformatter;
+template<typename T, std::size_t Size>
+class Chunks;
 
-    template<BitType, SizeType>
-    friend class BitUnformatter;
+template<BitType B, SizeType S>
+class BitUnformatter;
 
-public:
-    explicit constexpr Unformatter(std::span<T> data) : data_(data)
-    {
-    }
-    template<inner::SpanLike D>
-    explicit constexpr Unformatter(D &&data) : data_(inner::prepareSpan(data))
+namespace inner
+{
+    template<std::size_t RngStart, std::size_t RngSize>
+    consteval std::size_t rangeExtent()
     {
+        return RngSize == 1 ? RngStart : std::dynamic_extent;
     }
 
-    friend bool operator==(const Unformatter &left, const Unformatter &right)
+    // Common part of all unformatters. Ranges of a single size keep the size
+    // in the span extent and store only the pointer.
+    template<typename T, std::size_t Extent>
+    class UnformatterBase
     {
-        return std::ranges::equal(left.data_, right.data_);
-    }
+        template<typename, std::size_t>
+        friend class UnformatterBase;
 
-    constexpr operator std::span<T>() const
-    {
-        return data_;
-    }
-    constexpr operator std::string_view() const
-    requires inner::StringDataType<T>
-    {
-        return std::string_view(data_.begin(), data_.end());
-    }
-    constexpr std::span<T> operator*() const
-    {
-        return static_cast<std::span<T>>(*this);
-    }
+        template<typename, SizeType>
+        friend class unformatter::Unformatter;
 
-    auto begin() const
-    {
-        return data_.begin();
-    }
-    auto end() const
-    {
-        return data_.end();
-    }
+        template<BitType, SizeType>
+        friend class unformatter::BitUnformatter;
 
-    [[nodiscard]] constexpr std::optional<Unformatter> subs(
-        std::size_t offset, std::optional<std::size_t> maybeSize = {}) const
-    {
-        if(const auto maybeSubsSize =
-               inner::common::subsSize(offset, maybeSize, data_.size()))
+    public:
+        template<std::size_t SpanExtent>
+        requires(SpanExtent == Extent || SpanExtent == std::dynamic_extent)
+        constexpr operator std::span<T, SpanExtent>() const
         {
-            return Unformatter(data_.subspan(offset, *maybeSubsSize));
+            return data_;
+        }
+        constexpr operator std::string_view() const
+        requires inner::StringDataType<T>
+        {
+            return std::string_view(data_.begin(), data_.end());
+        }
+        constexpr std::span<T, Extent> operator*() const
+        {
+            return data_;
         }
-        return std::nullopt;
-    }
 
-    [[nodiscard]] std::optional<std::tuple<Unformatter, Unformatter>> split(
-        const std::size_t offset) const
-    {
-        if(offset > data_.size())
+        constexpr auto begin() const
+        {
+            return data_.begin();
+        }
+        constexpr auto end() const
         {
+            return data_.end();
+        }
+
+        [[nodiscard]] constexpr std::optional<Unformatter<T, DynamicSize>> subs(
+            std::size_t offset, std::optional<std::size_t> maybeSize = {}) const
+        {
+            if(const auto maybeSubsSize =
+                   inner::common::subsSize(offset, maybeSize, data_.size()))
+            {
+                return Unformatter<T, DynamicSize>(
+                    data_.subspan(offset, *maybeSubsSize));
+            }
+            stats::Policy::boundsFailure(stats::Site::subs);
             return std::nullopt;
         }
-        return std::tuple{subs(0, offset), subs(offset)};
-    }
 
-    template<typename V, std::endian Endian = std::endian::native>
-    [[nodiscard]] constexpr std::optional<V> read() const
-    {
-        if(bufferSize() != sizeof(V))
+        // Like subs and read without the result wrapping and bounds
+        // failures, the bounds are only verified by the check policy. The
+        // size defaults to the rest of the range.
+        template<CheckPolicy Check = DebugChecked>
+        [[nodiscard]] constexpr Unformatter<T, DynamicSize> subsUnchecked(
+            const std::size_t offset,
+            const std::size_t size = std::dynamic_extent) const
+        {
+            Check::check(offset <= data_.size() &&
+                         (size == std::dynamic_extent ||
+                          size <= data_.size() - offset));
+            return Unformatter<T, DynamicSize>(data_.subspan(offset, size));
+        }
+
+        template<typename V, std::endian Endian = std::endian::native,
+                 CheckPolicy Check = DebugChecked>
+        requires(sizeof(V) % sizeof(T) == 0)
+        [[nodiscard]] constexpr V readUnchecked() const
+        {
+            Check::check(bufferSize() == sizeof(V));
+            V dst[1]{};
+            copyBytes<Endian, sizeof(V)>(std::span{dst}, fieldData<V>());
+            return dst[0];
+        }
+
+        template<std::endian Endian = std::endian::native,
+                 CheckPolicy Check = DebugChecked, typename V>
+        requires(sizeof(V) % sizeof(T) == 0)
+        constexpr void writeUnchecked(const V val) const
+        {
+            Check::check(bufferSize() == sizeof(V));
+            const V src[1]{val};
+            copyBytes<Endian, sizeof(V)>(fieldData<V>(), std::span{src});
+        }
+
+        [[nodiscard]] constexpr std::optional<
+            std::tuple<Unformatter<T, DynamicSize>, Unformatter<T, DynamicSize>>>
+        split(const std::size_t offset) const
+        {
+            if(offset > data_.size())
+            {
+                stats::Policy::boundsFailure(stats::Site::split);
+                return std::nullopt;
+            }
+            return std::tuple{*subs(0, offset), *subs(offset)};
+        }
+
+        // Consecutive records of Size elements, the length is checked once
+        // for all of them. Elements after the last whole record are in
+        // remainder(). A nonzero prefetch distance prefetches the record
+        // that many records ahead of every dereferenced one.
+        template<std::size_t Size>
+        requires(Size > 0)
+        [[nodiscard]] constexpr Chunks<T, Size> chunks(
+            const std::size_t prefetchDistance = 0) const
+        {
+            return Chunks<T, Size>(data_, prefetchDistance);
+        }
+
+        template<typename V, std::endian Endian = std::endian::native>
+        [[nodiscard]] constexpr std::optional<V> read() const
+        {
+            if(bufferSize() != sizeof(V))
+            {
+                stats::Policy::boundsFailure(stats::Site::read);
+                return std::nullopt;
+            }
+            V dst[1]{};
+            copyBytes<Endian, sizeof(V)>(std::span{dst}, data_);
+            return dst[0];
+        }
+        // Native order copies at run time may overlap, like memmove.
+        // Swapping copies and copies in constant evaluation need separate
+        // or identical ranges.
+        template<std::endian Endian = std::endian::native, typename V,
+                 std::size_t OtherExtent>
+        [[nodiscard]] constexpr bool readCollection(
+            const UnformatterBase<V, OtherExtent> &other) const
         {
+            if(bufferSize() != other.bufferSize())
+            {
+                stats::Policy::boundsFailure(stats::Site::readCollection);
+                return false;
+            }
+            checkSeparate<Endian, sizeof(V)>(other.data_, data_);
+            copyBytes<Endian, sizeof(V)>(other.data_, data_);
+            return true;
+        }
+
+        template<std::endian Endian = std::endian::native, typename V>
+        [[nodiscard]] constexpr bool write(const V val) const
+        {
+            if(bufferSize() != sizeof(V))
+            {
+                stats::Policy::boundsFailure(stats::Site::write);
+                return false;
+            }
+            const V src[1]{val};
+            copyBytes<Endian, sizeof(V)>(data_, std::span{src});
+            return true;
+        }
+
+        // Integers of 1 to sizeof(V) bytes, like 3 byte lengths or 6 byte
+        // addresses. Reads zero or sign extend to V, writes store the low
+        // bytes of the value.
+        template<typename V, std::endian Endian = std::endian::native>
+        requires(std::integral<V> && !std::same_as<V, bool>)
+        [[nodiscard]] constexpr std::optional<V> readInteger() const
+        {
+            if(bufferSize() == 0 || bufferSize() > sizeof(V))
+            {
+                stats::Policy::boundsFailure(stats::Site::read);
+                return std::nullopt;
+            }
+            stats::Policy::bytesCopied(bufferSize(), integerSwaps<Endian>());
+            return inner::common::loadInteger<V, Endian>(data_, bufferSize());
+        }
+
+        template<std::endian Endian = std::endian::native, typename V>
+        requires(std::integral<V> && !std::same_as<V, bool>)
+        [[nodiscard]] constexpr bool writeInteger(const V val) const
+        {
+            if(bufferSize() == 0 || bufferSize() > sizeof(V))
+            {
+                stats::Policy::boundsFailure(stats::Site::write);
+                return false;
+            }
+            stats::Policy::bytesCopied(bufferSize(), integerSwaps<Endian>());
+            inner::common::storeInteger<Endian>(data_, bufferSize(), val);
+            return true;
+        }
+        template<std::endian Endian = std::endian::native, typename V,
+                 std::size_t OtherExtent>
+        [[nodiscard]] constexpr bool writeCollection(
+            const UnformatterBase<V, OtherExtent> &other) const
+        {
+            if(bufferSize() != other.bufferSize())
+            {
+                stats::Policy::boundsFailure(stats::Site::writeCollection);
+                return false;
+            }
+            checkSeparate<Endian, sizeof(V)>(data_, other.data_);
+            copyBytes<Endian, sizeof(V)>(data_, other.data_);
+            return true;
+        }
+
+        // Native order copies with non-temporal stores regardless of size,
+        // for data that won't be read again soon.
+        template<typename V, std::size_t OtherExtent>
+        [[nodiscard]] constexpr bool readCollectionStreaming(
+            const UnformatterBase<V, OtherExtent> &other) const
+        {
+            if(bufferSize() != other.bufferSize())
+            {
+                stats::Policy::boundsFailure(stats::Site::readCollection);
+                return false;
+            }
+            streamBytes(other.data_, data_);
+            return true;
+        }
+        template<typename V, std::size_t OtherExtent>
+        [[nodiscard]] constexpr bool writeCollectionStreaming(
+            const UnformatterBase<V, OtherExtent> &other) const
+        {
+            if(bufferSize() != other.bufferSize())
+            {
+                stats::Policy::boundsFailure(stats::Site::writeCollection);
+                return false;
+            }
+            streamBytes(data_, other.data_);
+            return true;
+        }
+
+        template<std::integral V>
+        requires inner::StringDataType<T>
+        [[nodiscard]] constexpr std::optional<V> readString(
+            const unsigned int base = 10) const
+        {
+            if(std::is_constant_evaluated())
+            {
+                return inner::common::parseInteger<V>(std::span<T>(data_),
+                                                      base);
+            }
+            const auto *first = data_.data();
+            const auto *last = first + data_.size();
+            V result{};
+            const auto res = std::from_chars(first, last, result, base);
+            if(res.ec == std::errc{} && res.ptr == last)
+            {
+                return result;
+            }
             return std::nullopt;
         }
-        V dst[1]{};
-        std::ranges::copy(
-            inner::common::asEndianBytes<Endian>(std::as_bytes(data_)),
-            std::as_writable_bytes(std::span{dst}).begin());
-        return dst[0];
-    }
-    template<std::endian Endian = std::endian::native, typename V>
-    [[nodiscard]] constexpr bool readCollection(
-        const Unformatter<V, DynamicSize> &other) const
-    {
-        if(bufferSize() != other.bufferSize())
+
+        [[nodiscard]] constexpr std::size_t size() const
         {
-            return false;
+            return data_.size();
         }
-        copyBytes<Endian>(std::as_writable_bytes(other.data_),
-                          std::as_bytes(data_), sizeof(V));
-        return true;
-    }
 
-    template<std::endian Endian = std::endian::native, typename V>
-    [[nodiscard]] constexpr bool write(const V val) const
-    {
-        if(bufferSize() != sizeof(V))
+    protected:
+        explicit constexpr UnformatterBase(std::span<T, Extent> data)
+            : data_(data)
         {
-            return false;
         }
-        const V src[1]{val};
-        std::ranges::copy(
-            inner::common::asEndianBytes<Endian>(std::as_bytes(std::span{src})),
-            std::as_writable_bytes(data_).begin());
-        return true;
-    }
-    template<std::endian Endian = std::endian::native, typename V>
-    [[nodiscard]] constexpr bool writeCollection(
-        const Unformatter<V, DynamicSize> &other) const
-    {
-        if(bufferSize() != other.bufferSize())
+
+        [[nodiscard]]
+        constexpr std::size_t bufferSize() const
         {
-            return false;
+            return data_.size() * sizeof(T);
         }
-        copyBytes<Endian>(std::as_writable_bytes(data_),
-                          std::as_bytes(other.data_), sizeof(V));
-        return true;
-    }
 
-    template<std::integral V>
-    requires inner::StringDataType<T>
-    [[nodiscard]] std::optional<V> readString(
-        const unsigned int base = 10) const
-    {
-        const auto *first = data_.data();
-        const auto *last = first + data_.size();
-        V result{};
-        const auto res = std::from_chars(first, last, result, base);
-        if(res.ec == std::errc{} && res.ptr == last)
+        template<std::endian Endian, std::size_t ChunkSize, typename Dst,
+                 std::size_t DstExtent, typename Src, std::size_t SrcExtent>
+        static constexpr void copyBytes(std::span<Dst, DstExtent> dst,
+                                        std::span<Src, SrcExtent> src)
         {
-            return result;
+            constexpr bool SWAP =
+                !inner::common::isNativeEndianness<Endian>() && ChunkSize != 1;
+            const auto size = src.size_bytes();
+            assert(size == dst.size_bytes());
+            assert(size % ChunkSize == 0);
+            stats::Policy::bytesCopied(size, SWAP ? size / ChunkSize : 0);
+            if(std::is_constant_evaluated())
+            {
+                for(std::size_t idx = 0; idx < size; ++idx)
+                {
+                    const auto pos = idx % ChunkSize;
+                    inner::common::storeByte(
+                        dst, idx,
+                        inner::common::loadByte(
+                            src, SWAP ? idx - pos + ChunkSize - 1 - pos : idx));
+                }
+            }
+            else
+            {
+                copyRawBytes<SWAP, ChunkSize>(std::as_writable_bytes(dst),
+                                              std::as_bytes(src));
+            }
         }
-        return std::nullopt;
-    }
 
-    [[nodiscard]] constexpr std::size_t size() const
-    {
-        return data_.size();
-    }
+        // Swapping copies go a chunk at a time, so ranges overlapping at
+        // another position would read bytes already swapped.
+        template<std::endian Endian, std::size_t ChunkSize, typename Dst,
+                 std::size_t DstExtent, typename Src, std::size_t SrcExtent>
+        static constexpr void checkSeparate(std::span<Dst, DstExtent> dst,
+                                            std::span<Src, SrcExtent> src)
+        {
+            if(!std::is_constant_evaluated() &&
+               !inner::common::isNativeEndianness<Endian>() && ChunkSize != 1)
+            {
+                const auto *const dstData = std::as_bytes(dst).data();
+                const auto *const srcData = std::as_bytes(src).data();
+                DebugChecked::check(dstData == srcData ||
+                                    !inner::copy::overlaps(
+                                        dstData, srcData, src.size_bytes()));
+            }
+        }
 
-protected:
-    [[nodiscard]]
-    constexpr std::size_t bufferSize() const
-    {
-        return data_.size() * sizeof(T);
-    }
+        template<typename Dst, std::size_t DstExtent, typename Src,
+                 std::size_t SrcExtent>
+        static constexpr void streamBytes(std::span<Dst, DstExtent> dst,
+                                          std::span<Src, SrcExtent> src)
+        {
+            if(std::is_constant_evaluated())
+            {
+                copyBytes<std::endian::native, 1>(dst, src);
+                return;
+            }
+            stats::Policy::bytesCopied(src.size_bytes(), 0);
+            inner::copy::streamBytes(std::as_writable_bytes(dst).data(),
+                                     std::as_bytes(src).data(),
+                                     src.size_bytes());
+        }
 
-    std::span<T> data_;
+        template<std::endian Endian>
+        constexpr std::size_t integerSwaps() const
+        {
+            return inner::common::isNativeEndianness<Endian>() ||
+                           bufferSize() == 1
+                       ? 0
+                       : 1;
+        }
 
-private:
-    template<std::endian Endian>
-    static constexpr void copyBytes(std::span<std::byte> dst,
-                                    std::span<const std::byte> src,
-                                    const std::size_t chunkSize)
-    {
-        assert(src.size() == dst.size());
-        assert(src.size() % chunkSize == 0);
-        if constexpr(inner::common::isNativeEndianness<Endian>())
+        std::span<T, Extent> data_;
+
+    private:
+        // Leading elements of the size of a V, the size is trusted.
+        template<typename V>
+        constexpr std::span<T, sizeof(V) / sizeof(T)> fieldData() const
         {
-            std::ranges::copy(src, dst.begin());
+            return std::span<T, sizeof(V) / sizeof(T)>(data_.data(),
+                                                       sizeof(V) / sizeof(T));
         }
-        else
+
+        template<bool Swap, std::size_t ChunkSize, std::size_t DstExtent,
+                 std::size_t SrcExtent>
+        static void copyRawBytes(std::span<std::byte, DstExtent> dst,
+                                 std::span<const std::byte, SrcExtent> src)
         {
-            for(auto offset = decltype(chunkSize){}; offset < src.size();
-                offset += chunkSize)
+            if constexpr(!Swap)
             {
-                std::ranges::copy(inner::common::asEndianBytes<Endian>(
-                                      src.subspan(offset, chunkSize)),
-                                  dst.subspan(offset, chunkSize).begin());
+                constexpr auto EXTENT =
+                    DstExtent != std::dynamic_extent ? DstExtent : SrcExtent;
+                inner::copy::copyBytes<EXTENT>(dst.data(), src.data(),
+                                               src.size());
+            }
+            else
+            {
+                for(auto offset = std::size_t{}; offset < src.size();
+                    offset += ChunkSize)
+                {
+                    swapChunk<ChunkSize>(dst.subspan(offset, ChunkSize),
+                                         src.subspan(offset, ChunkSize));
+                }
+            }
+        }
+
+        template<std::size_t ChunkSize>
+        static void swapChunk(std::span<std::byte> dst,
+                              std::span<const std::byte> src)
+        {
+            if constexpr(inner::common::HasUnsignedOfSize<ChunkSize>)
+            {
+                using Chunk = std::array<std::byte, ChunkSize>;
+                Chunk chunk{};
+                std::ranges::copy(src, chunk.begin());
+                chunk = std::bit_cast<Chunk>(inner::common::byteswap(
+                    std::bit_cast<typename inner::common::UnsignedOfSize<
+                        ChunkSize>::Type>(chunk)));
+                std::ranges::copy(chunk, dst.begin());
+            }
+            else
+            {
+                std::ranges::copy(src | std::views::reverse, dst.begin());
             }
         }
+    };
+}
+
+template<typename T>
+class Unformatter<T, DynamicSize>
+    : public inner::UnformatterBase<T, std::dynamic_extent>
+{
+    using Base = inner::UnformatterBase<T, std::dynamic_extent>;
+
+public:
+    explicit constexpr Unformatter(std::span<T> data) : Base(data)
+    {
+    }
+    template<inner::SpanLike D>
+    explicit constexpr Unformatter(D &&data) : Base(inner::prepareSpan(data))
+    {
+    }
+    template<std::size_t Extent>
+    constexpr Unformatter(const inner::UnformatterBase<T, Extent> &other)
+        : Base(other.data_)
+    {
+    }
+
+    // Byte comparisons of trivial elements use memcmp.
+    friend constexpr bool operator==(const Unformatter &left,
+                                     const Unformatter &right)
+    {
+        return inner::common::equalRanges(left.data_, right.data_);
+    }
+    friend constexpr auto operator<=>(const Unformatter &left,
+                                      const Unformatter &right)
+    requires std::three_way_comparable<T>
+    {
+        return inner::common::compareRanges(left.data_, right.data_);
     }
 };
 
-template<typename T, std::size_t RngStart, std::size_t RngSize>
-class Unformatter<T, RangeSize<RngStart, RngSize>>
-    : public Unformatter<T, DynamicSize>
+template<typename T, std::size_t RngStart, std::size_t RngSize,
+         std::size_t RngAlignment>
+class Unformatter<T, RangeSize<RngStart, RngSize, RngAlignment>>
+    : public inner::UnformatterBase<T, inner::rangeExtent<RngStart, RngSize>()>
 {
     static_assert(std::is_trivial_v<T>);
 
     template<typename, SizeType>
     friend class Unformatter;
 
-    using SzType = RangeSize<RngStart, RngSize>;
+    static constexpr auto EXTENT = inner::rangeExtent<RngStart, RngSize>();
+
+    using SzType = RangeSize<RngStart, RngSize, RngAlignment>;
+    using Base = inner::UnformatterBase<T, EXTENT>;
+
+    template<std::size_t Offset>
+    static constexpr auto SUBS_ALIGNMENT =
+        inner::subsAlignment<RngAlignment, Offset * sizeof(T)>();
+    static constexpr auto ALIGNMENT = std::max(RngAlignment, alignof(T));
 
 public:
     template<inner::SpanLike D>
     [[nodiscard]] constexpr static std::optional<Unformatter> create(D &&data)
     {
         const auto span = inner::prepareSpan(data);
-        if(inner::isInRange<SzType>(span.size()))
+        if(inner::isInRange<SzType>(span.size()) &&
+           inner::isAligned<RngAlignment>(span.data()))
         {
-            return Unformatter(span);
+            return Unformatter(
+                std::span<T, EXTENT>(span.data(), span.size()));
         }
+        stats::Policy::boundsFailure(stats::Site::create);
         return std::nullopt;
     }
 
@@ -278,29 +610,44 @@ public:
              sizeof(V) == inner::bufferSize<T, RngStart>())
     [[nodiscard]] constexpr V read() const
     {
-        return *Unformatter<T, DynamicSize>::template read<V, Endian>();
+        V dst[1]{};
+        Base::template copyBytes<Endian, sizeof(V)>(std::span{dst},
+                                                    alignedData());
+        return dst[0];
+    }
+
+    template<typename V, std::endian Endian = std::endian::native>
+    requires(RngSize == 1 &&
+             inner::ShortIntegerField<V, inner::bufferSize<T, RngStart>()>)
+    [[nodiscard]] constexpr V readInteger() const
+    {
+        stats::Policy::bytesCopied(this->bufferSize(),
+                                   this->template integerSwaps<Endian>());
+        return inner::common::loadInteger<V, Endian>(
+            alignedData(), inner::bufferSize<T, RngStart>());
     }
 
-    using Unformatter<T, DynamicSize>::readCollection;
+    using Base::readCollection;
 
     template<std::endian Endian = std::endian::native, typename V,
-             std::size_t OtherRngStart, std::size_t OtherRngSize>
+             std::size_t OtherRngStart, std::size_t OtherRngSize,
+             std::size_t OtherRngAlignment>
     constexpr void readCollection(
-        const Unformatter<V, RangeSize<OtherRngStart, OtherRngSize>> &other) =
+        const Unformatter<V, RangeSize<OtherRngStart, OtherRngSize,
+                                       OtherRngAlignment>> &other) const =
         delete;
     template<std::endian Endian = std::endian::native, typename V,
-             std::size_t OtherRngStart, std::size_t OtherRngSize>
+             std::size_t OtherRngStart, std::size_t OtherRngSize,
+             std::size_t OtherRngAlignment>
     requires(std::is_trivial_v<V> && RngSize == 1 && OtherRngSize == 1 &&
              inner::bufferSize<T, RngStart>() ==
                  inner::bufferSize<V, OtherRngStart>())
     constexpr void readCollection(
-        const Unformatter<V, RangeSize<OtherRngStart, OtherRngSize>> &other)
-        const
+        const Unformatter<V, RangeSize<OtherRngStart, OtherRngSize,
+                                       OtherRngAlignment>> &other) const
     {
-        [[maybe_unused]]
-        const auto res =
-            Unformatter<T, DynamicSize>::template readCollection<Endian>(other);
-        assert(res);
+        Base::template copyBytes<Endian, sizeof(V)>(other.alignedData(),
+                                                    alignedData());
     }
 
     template<std::endian Endian = std::endian::native, typename V>
@@ -308,36 +655,95 @@ public:
              sizeof(V) == inner::bufferSize<T, RngStart>())
     constexpr void write(const V val) const
     {
-        [[maybe_unused]]
-        const auto res =
-            Unformatter<T, DynamicSize>::template write<Endian>(val);
-        assert(res);
+        const V src[1]{val};
+        Base::template copyBytes<Endian, sizeof(V)>(alignedData(),
+                                                    std::span{src});
+    }
+
+    template<std::endian Endian = std::endian::native, typename V>
+    requires(RngSize == 1 &&
+             inner::ShortIntegerField<V, inner::bufferSize<T, RngStart>()>)
+    constexpr void writeInteger(const V val) const
+    {
+        stats::Policy::bytesCopied(this->bufferSize(),
+                                   this->template integerSwaps<Endian>());
+        inner::common::storeInteger<Endian>(
+            alignedData(), inner::bufferSize<T, RngStart>(), val);
+    }
+
+    // Atomic accesses of the range as a V in native byte order, for fields
+    // shared between threads or processes. Available when the range
+    // alignment allows a lock-free std::atomic_ref<V>.
+    template<typename V>
+    requires(RngSize == 1 &&
+             inner::AtomicField<T, V, inner::bufferSize<T, RngStart>(),
+                                ALIGNMENT>)
+    [[nodiscard]] V atomicLoad(
+        const std::memory_order order = std::memory_order_seq_cst) const
+    {
+        return atomicRef<V>().load(order);
+    }
+
+    template<typename V>
+    requires(RngSize == 1 &&
+             inner::AtomicField<T, V, inner::bufferSize<T, RngStart>(),
+                                ALIGNMENT>)
+    void atomicStore(
+        const V val,
+        const std::memory_order order = std::memory_order_seq_cst) const
+    {
+        atomicRef<V>().store(val, order);
+    }
+
+    template<typename V>
+    requires(RngSize == 1 &&
+             inner::AtomicField<T, V, inner::bufferSize<T, RngStart>(),
+                                ALIGNMENT> &&
+             requires(const std::atomic_ref<V> ref) { ref.fetch_add(V{}); })
+    V fetchAdd(const V arg,
+               const std::memory_order order = std::memory_order_seq_cst) const
+    {
+        return atomicRef<V>().fetch_add(arg, order);
     }
 
-    using Unformatter<T, DynamicSize>::writeCollection;
+    // Strong compare exchange, on failure expected gets the current value.
+    template<typename V>
+    requires(RngSize == 1 &&
+             inner::AtomicField<T, V, inner::bufferSize<T, RngStart>(),
+                                ALIGNMENT>)
+    [[nodiscard]] bool compareExchange(
+        V &expected, const V desired,
+        const std::memory_order success = std::memory_order_seq_cst,
+        const std::memory_order failure = std::memory_order_seq_cst) const
+    {
+        return atomicRef<V>().compare_exchange_strong(expected, desired,
+                                                      success, failure);
+    }
+
+    using Base::writeCollection;
 
     template<std::endian Endian = std::endian::native, typename V,
-             std::size_t OtherRngStart, std::size_t OtherRngSize>
+             std::size_t OtherRngStart, std::size_t OtherRngSize,
+             std::size_t OtherRngAlignment>
     constexpr void writeCollection(
-        const Unformatter<V, RangeSize<OtherRngStart, OtherRngSize>> &other)
-        const = delete;
+        const Unformatter<V, RangeSize<OtherRngStart, OtherRngSize,
+                                       OtherRngAlignment>> &other) const =
+        delete;
     template<std::endian Endian = std::endian::native, typename V,
-             std::size_t OtherRngStart, std::size_t OtherRngSize>
+             std::size_t OtherRngStart, std::size_t OtherRngSize,
+             std::size_t OtherRngAlignment>
     requires(std::is_trivial_v<V> && RngSize == 1 && OtherRngSize == 1 &&
              inner::bufferSize<T, RngStart>() ==
                  inner::bufferSize<V, OtherRngStart>())
     constexpr void writeCollection(
-        const Unformatter<V, RangeSize<OtherRngStart, OtherRngSize>> &other)
-        const
+        const Unformatter<V, RangeSize<OtherRngStart, OtherRngSize,
+                                       OtherRngAlignment>> &other) const
     {
-        [[maybe_unused]]
-        const auto res =
-            Unformatter<T, DynamicSize>::template writeCollection<Endian>(
-                other);
-        assert(res);
+        Base::template copyBytes<Endian, sizeof(V)>(alignedData(),
+                                                    other.alignedData());
     }
 
-    using Unformatter<T, DynamicSize>::subs;
+    using Base::subs;
 
     template<std::size_t Offset,
              inner::common::LiteralOptional<std::size_t> SubsSize =
@@ -347,64 +753,278 @@ public:
     {
         if constexpr(SubsSize.null)
         {
-            return Unformatter<T, RangeSize<RngStart - Offset, RngSize>>(
-                Unformatter<T, DynamicSize>::subs(Offset)->data_);
+            return Unformatter<T, RangeSize<RngStart - Offset, RngSize,
+                                            SUBS_ALIGNMENT<Offset>>>(
+                this->data_.template subspan<Offset>());
         }
         else
         {
-            return Unformatter<T, RangeSize<SubsSize.value, 1>>(
-                Unformatter<T, DynamicSize>::subs(Offset, SubsSize.value)
-                    ->data_);
+            return Unformatter<T, RangeSize<SubsSize.value, 1,
+                                            SUBS_ALIGNMENT<Offset>>>(
+                this->data_.template subspan<Offset, SubsSize.value>());
         }
     }
 
     template<std::size_t Offset>
     requires(Offset <= RngStart)
-    [[nodiscard]] auto split() const
+    [[nodiscard]] constexpr auto split() const
     {
         return std::tuple{subs<0, Offset>(), subs<Offset>()};
     }
 
-    template<std::size_t NewRngStart, std::size_t NewRngSize>
-    requires((NewRngStart != RngStart || NewRngSize != RngSize) &&
+    template<std::size_t NewRngStart, std::size_t NewRngSize,
+             std::size_t NewRngAlignment>
+    requires((NewRngStart != RngStart || NewRngSize != RngSize ||
+              NewRngAlignment != RngAlignment) &&
              NewRngStart <= RngStart && NewRngSize >= RngSize &&
-             RngStart - NewRngStart <= NewRngSize - RngSize)
-    constexpr operator Unformatter<T, RangeSize<NewRngStart, NewRngSize>>()
+             RngStart - NewRngStart <= NewRngSize - RngSize &&
+             NewRngAlignment <= RngAlignment)
+    constexpr
+    operator Unformatter<T,
+                         RangeSize<NewRngStart, NewRngSize, NewRngAlignment>>()
         const
     {
-        return Unformatter<T, RangeSize<NewRngStart, NewRngSize>>(this->data_);
+        return Unformatter<T,
+                           RangeSize<NewRngStart, NewRngSize, NewRngAlignment>>(
+            this->data_);
     }
 
 private:
-    constexpr explicit Unformatter(std::span<T> data)
-        : Unformatter<T, DynamicSize>(data)
+    constexpr explicit Unformatter(std::span<T, EXTENT> data) : Base(data)
+    {
+    }
+
+    constexpr std::span<T, EXTENT> alignedData() const
+    {
+        return std::span<T, EXTENT>(
+            std::assume_aligned<ALIGNMENT>(this->data_.data()),
+            this->data_.size());
+    }
+
+    template<typename V>
+    std::atomic_ref<V> atomicRef() const
     {
+        return std::atomic_ref<V>(*std::assume_aligned<ALIGNMENT>(
+            reinterpret_cast<V *>(this->data_.data())));
     }
 };
 
 template<typename V, std::size_t LeftStart, std::size_t LeftSize,
-         std::size_t RightStart, std::size_t RightSize>
-bool operator==(const Unformatter<V, RangeSize<LeftStart, LeftSize>> &left,
-                const Unformatter<V, RangeSize<RightStart, RightSize>> &right) =
-    delete;
+         std::size_t LeftAlignment, std::size_t RightStart,
+         std::size_t RightSize, std::size_t RightAlignment>
+bool operator==(
+    const Unformatter<V, RangeSize<LeftStart, LeftSize, LeftAlignment>> &left,
+    const Unformatter<V, RangeSize<RightStart, RightSize, RightAlignment>>
+        &right) = delete;
 template<typename V, std::size_t LeftStart, std::size_t LeftSize,
-         std::size_t RightStart, std::size_t RightSize>
-bool operator==(const Unformatter<V, RangeSize<LeftStart, LeftSize>> &left,
-                const Unformatter<V, RangeSize<RightStart, RightSize>> &right)
+         std::size_t LeftAlignment, std::size_t RightStart,
+         std::size_t RightSize, std::size_t RightAlignment>
+constexpr bool operator==(
+    const Unformatter<V, RangeSize<LeftStart, LeftSize, LeftAlignment>> &left,
+    const Unformatter<V, RangeSize<RightStart, RightSize, RightAlignment>>
+        &right)
 requires(inner::isIntersectingRanges<RangeSize<LeftStart, LeftSize>,
                                      RangeSize<RightStart, RightSize>>())
 {
-    using U = Unformatter<V, DynamicSize>;
-    return static_cast<const U &>(left) == static_cast<const U &>(right);
+    return inner::common::equalRanges(*left, *right);
+}
+
+template<typename V, std::size_t LeftStart, std::size_t LeftSize,
+         std::size_t LeftAlignment, std::size_t RightStart,
+         std::size_t RightSize, std::size_t RightAlignment>
+auto operator<=>(
+    const Unformatter<V, RangeSize<LeftStart, LeftSize, LeftAlignment>> &left,
+    const Unformatter<V, RangeSize<RightStart, RightSize, RightAlignment>>
+        &right) = delete;
+template<typename V, std::size_t LeftStart, std::size_t LeftSize,
+         std::size_t LeftAlignment, std::size_t RightStart,
+         std::size_t RightSize, std::size_t RightAlignment>
+constexpr auto operator<=>(
+    const Unformatter<V, RangeSize<LeftStart, LeftSize, LeftAlignment>> &left,
+    const Unformatter<V, RangeSize<RightStart, RightSize, RightAlignment>>
+        &right)
+requires(std::three_way_comparable<V> &&
+         inner::isIntersectingRanges<RangeSize<LeftStart, LeftSize>,
+                                     RangeSize<RightStart, RightSize>>())
+{
+    return inner::common::compareRanges(*left, *right);
 }
 
 template<typename T>
 using UnformatterDynamic = Unformatter<T, DynamicSize>;
-template<typename T, std::size_t Size>
-using UnformatterStatic = Unformatter<T, StaticSize<Size>>;
-template<typename T, std::size_t Start, std::size_t End>
+template<typename T, std::size_t Size, std::size_t Alignment = 1>
+using UnformatterStatic = Unformatter<T, StaticSize<Size, Alignment>>;
+template<typename T, std::size_t Start, std::size_t End,
+         std::size_t Alignment = 1>
 requires(Start <= End)
-using UnformatterRanged = Unformatter<T, RangeSize<Start, End - Start + 1>>;
+using UnformatterRanged =
+    Unformatter<T, RangeSize<Start, End - Start + 1, Alignment>>;
+
+namespace inner
+{
+    inline void prefetch([[maybe_unused]] const void *const ptr)
+    {
+#if defined(__GNUC__)
+        __builtin_prefetch(ptr);
+#endif
+    }
+}
+
+// Random access range of the records of Unformatter::chunks. Iterators
+// yield records by value. Their category is random access for the standard
+// algorithms, parallel ones included, though references aren't real ones.
+template<typename T, std::size_t Size>
+class Chunks : public std::ranges::view_interface<Chunks<T, Size>>
+{
+    template<typename, std::size_t>
+    friend class inner::UnformatterBase;
+
+public:
+    using Record = UnformatterStatic<T, Size>;
+
+    class Iterator
+    {
+        friend class Chunks;
+
+    public:
+        // Dereferencing yields records by value, so the legacy category
+        // can only be input.
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Record;
+        using difference_type = std::ptrdiff_t;
+        using reference = Record;
+
+        constexpr Iterator() = default;
+
+        constexpr Record operator*() const
+        {
+            return (*this)[0];
+        }
+        constexpr Record operator[](const difference_type offset) const
+        {
+            const auto index = static_cast<std::size_t>(
+                static_cast<difference_type>(index_) + offset);
+            if(!std::is_constant_evaluated() && prefetch_ != 0 &&
+               prefetch_ < count_ - index)
+            {
+                inner::prefetch(data_ + (index + prefetch_) * Size);
+            }
+            return *Record::create(std::span<T, Size>(data_ + index * Size,
+                                                      Size));
+        }
+
+        constexpr Iterator &operator++()
+        {
+            ++index_;
+            return *this;
+        }
+        constexpr Iterator operator++(int)
+        {
+            auto prev = *this;
+            ++index_;
+            return prev;
+        }
+        constexpr Iterator &operator--()
+        {
+            --index_;
+            return *this;
+        }
+        constexpr Iterator operator--(int)
+        {
+            auto prev = *this;
+            --index_;
+            return prev;
+        }
+        constexpr Iterator &operator+=(const difference_type offset)
+        {
+            index_ = static_cast<std::size_t>(
+                static_cast<difference_type>(index_) + offset);
+            return *this;
+        }
+        constexpr Iterator &operator-=(const difference_type offset)
+        {
+            return *this += -offset;
+        }
+
+        friend constexpr Iterator operator+(Iterator it,
+                                            const difference_type offset)
+        {
+            return it += offset;
+        }
+        friend constexpr Iterator operator+(const difference_type offset,
+                                            Iterator it)
+        {
+            return it += offset;
+        }
+        friend constexpr Iterator operator-(Iterator it,
+                                            const difference_type offset)
+        {
+            return it -= offset;
+        }
+        friend constexpr difference_type operator-(const Iterator &left,
+                                                   const Iterator &right)
+        {
+            return static_cast<difference_type>(left.index_) -
+                   static_cast<difference_type>(right.index_);
+        }
+
+        friend constexpr bool operator==(const Iterator &left,
+                                         const Iterator &right)
+        {
+            return left.index_ == right.index_;
+        }
+        friend constexpr auto operator<=>(const Iterator &left,
+                                          const Iterator &right)
+        {
+            return left.index_ <=> right.index_;
+        }
+
+    private:
+        constexpr Iterator(T *data, const std::size_t index,
+                           const std::size_t count,
+                           const std::size_t prefetch)
+            : data_(data), index_(index), count_(count), prefetch_(prefetch)
+        {
+        }
+
+        T *data_ = nullptr;
+        std::size_t index_ = 0;
+        std::size_t count_ = 0;
+        std::size_t prefetch_ = 0;
+    };
+
+    constexpr Chunks() = default;
+
+    constexpr Iterator begin() const
+    {
+        return Iterator(data_.data(), 0, size(), prefetch_);
+    }
+    constexpr Iterator end() const
+    {
+        return Iterator(data_.data(), size(), size(), prefetch_);
+    }
+
+    [[nodiscard]] constexpr std::size_t size() const
+    {
+        return data_.size() / Size;
+    }
+
+    // Elements after the last whole record.
+    [[nodiscard]] constexpr UnformatterDynamic<T> remainder() const
+    {
+        return UnformatterDynamic<T>(data_.subspan(size() * Size));
+    }
+
+private:
+    constexpr Chunks(const std::span<T> data, const std::size_t prefetch)
+        : data_(data), prefetch_(prefetch)
+    {
+    }
+
+    std::span<T> data_;
+    std::size_t prefetch_ = 0;
+};
 
 template<std::size_t Start, std::size_t End = Start, inner::SpanLike D>
 requires(Start <= End)
@@ -414,12 +1034,36 @@ constexpr auto create(D &&data)
     return UnformatterRanged<typename decltype(span)::element_type, Start,
                              End>::create(span);
 }
-template<std::size_t Start, std::size_t End = Start, typename T>
+template<std::size_t Start, std::size_t End = Start, typename T,
+         std::size_t Extent>
 requires(Start <= End)
-constexpr auto create(Unformatter<T, DynamicSize> data)
+constexpr auto create(const inner::UnformatterBase<T, Extent> &data)
 {
     return UnformatterRanged<T, Start, End>::create(*data);
 }
+
+// Fails when the data doesn't start at the alignment, accesses through the
+// result may then use aligned loads and stores.
+template<std::size_t Alignment, std::size_t Start, std::size_t End = Start,
+         inner::SpanLike D>
+requires(Start <= End)
+constexpr auto createAligned(D &&data)
+{
+    auto span = inner::prepareSpan(data);
+    return UnformatterRanged<typename decltype(span)::element_type, Start, End,
+                             Alignment>::create(span);
+}
+template<std::size_t Alignment, std::size_t Start, std::size_t End = Start,
+         typename T, std::size_t Extent>
+requires(Start <= End)
+constexpr auto createAligned(const inner::UnformatterBase<T, Extent> &data)
+{
+    return UnformatterRanged<T, Start, End, Alignment>::create(*data);
+}
 }
 
+template<typename T, std::size_t Size>
+inline constexpr bool
+    std::ranges::enable_borrowed_range<unformatter::Chunks<T, Size>> = true;
+
 #endif
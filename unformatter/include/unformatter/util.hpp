@@ -1,8 +1,10 @@
 #ifndef UNFORMATTER_UTIL_HPP
 #define UNFORMATTER_UTIL_HPP
 
+#include <array>
 #include <cstddef>
 #include <tuple>
+#include <utility>
 
 #include "unformatter/inner/util.hpp"
 
@@ -10,28 +12,44 @@ namespace unformatter::util
 {
 namespace inner
 {
-    template<std::size_t Offset, typename U>
-    constexpr auto split(const U &unformatter)
+    // All slices are created in one pack expansion, the offsets are looked
+    // up in an array instead of peeled off recursively.
+    template<std::size_t... Offsets, typename U, typename F,
+             std::size_t... Idx>
+    constexpr decltype(auto) visitSplit(const U &unformatter, F &&func,
+                                        std::index_sequence<Idx...>)
     {
-        return std::tuple{unformatter.template subs<Offset>()};
-    }
-    template<std::size_t Offset1, std::size_t Offset2, std::size_t... Offsets,
-             typename U>
-    constexpr auto split(const U &unformatter)
-    {
-        return std::tuple_cat(
-            std::tuple{unformatter.template subs<Offset1, Offset2 - Offset1>()},
-            split<Offset2, Offsets...>(unformatter));
+        constexpr std::array<std::size_t, sizeof...(Offsets) + 1> STARTS{
+            0, Offsets...};
+        return std::forward<F>(func)(
+            unformatter.template subs<STARTS[Idx],
+                                      STARTS[Idx + 1] - STARTS[Idx]>()...,
+            unformatter.template subs<STARTS.back()>());
     }
 }
 
+// Calls func with the slices of split<Offsets...>() as arguments. Does not
+// build the tuple, which is the dominant compile cost for large layouts.
+template<std::size_t... Offsets, typename U, typename F>
+constexpr decltype(auto) visitSplit(const U &unformatter, F &&func)
+requires requires(const U &unformatter) {
+    unformatter.template subs<unformatter::inner::util::lastIndex<
+        Offsets...>()>();
+} && (unformatter::inner::util::areNondecreasingIndices<Offsets...>())
+{
+    return inner::visitSplit<Offsets...>(
+        unformatter, std::forward<F>(func),
+        std::make_index_sequence<sizeof...(Offsets)>{});
+}
+
 template<std::size_t... Offsets, typename U>
 constexpr auto split(const U &unformatter)
 requires requires(const U &unformatter) {
-    (unformatter.template subs<0, Offsets>(), ...);
-} && (unformatter::inner::util::areNondecreasingIndices<Offsets...>())
+    util::visitSplit<Offsets...>(unformatter, [](const auto &...) {});
+}
 {
-    return inner::split<0, Offsets...>(unformatter);
+    return util::visitSplit<Offsets...>(
+        unformatter, [](const auto... slices) { return std::tuple{slices...}; });
 }
 }
 
@@ -0,0 +1,86 @@
+# Checks disassembly of the codegen object.
+#
+# OBJDUMP - objdump executable
+# OBJECT - object file to inspect
+# BUDGETS - list of function=instruction budget pairs, or bare function
+#           names that are checked without a budget
+#
+# A function fails when it has more instructions than its budget, when it
+# calls or tail calls anything, or when it jumps backwards (a loop).
+
+execute_process(COMMAND "${OBJDUMP}" -d --no-show-raw-insn "${OBJECT}"
+    OUTPUT_VARIABLE DISASM
+    RESULT_VARIABLE RES)
+if(NOT RES EQUAL 0)
+    message(FATAL_ERROR "objdump failed for ${OBJECT}")
+endif()
+
+string(REPLACE ";" "\;" DISASM "${DISASM}")
+string(REPLACE "\n" ";" LINES "${DISASM}")
+
+set(FAILED FALSE)
+foreach(BUDGET_ENTRY ${BUDGETS})
+    string(REPLACE "=" ";" BUDGET_PAIR "${BUDGET_ENTRY}")
+    list(GET BUDGET_PAIR 0 FUNC)
+    set(BUDGET "")
+    list(LENGTH BUDGET_PAIR BUDGET_PAIR_LENGTH)
+    if(BUDGET_PAIR_LENGTH GREATER 1)
+        list(GET BUDGET_PAIR 1 BUDGET)
+    endif()
+
+    set(INSIDE FALSE)
+    set(FOUND FALSE)
+    set(COUNT 0)
+    set(ERRORS "")
+    foreach(LINE ${LINES})
+        if(LINE MATCHES "^[0-9a-f]+ <([^>]+)>:$")
+            if(CMAKE_MATCH_1 STREQUAL FUNC)
+                set(INSIDE TRUE)
+                set(FOUND TRUE)
+            else()
+                set(INSIDE FALSE)
+            endif()
+        elseif(INSIDE AND LINE MATCHES "^ *([0-9a-f]+):\t([a-z0-9]+)(.*)$")
+            set(ADDR "${CMAKE_MATCH_1}")
+            set(MNEMONIC "${CMAKE_MATCH_2}")
+            set(OPERANDS "${CMAKE_MATCH_3}")
+            if(MNEMONIC MATCHES "^(nop|data16|xchg|int3|cs)")
+                continue()
+            endif()
+            math(EXPR COUNT "${COUNT} + 1")
+            if(MNEMONIC MATCHES "^call")
+                list(APPEND ERRORS "call at ${ADDR}")
+            elseif(MNEMONIC MATCHES "^j" AND
+                   OPERANDS MATCHES "([0-9a-f]+) <([^+>]+)")
+                set(TARGET "${CMAKE_MATCH_1}")
+                if(NOT CMAKE_MATCH_2 STREQUAL FUNC)
+                    list(APPEND ERRORS "tail call at ${ADDR}")
+                else()
+                    math(EXPR TARGET_VAL "0x${TARGET}")
+                    math(EXPR ADDR_VAL "0x${ADDR}")
+                    if(NOT TARGET_VAL GREATER ADDR_VAL)
+                        list(APPEND ERRORS "loop at ${ADDR}")
+                    endif()
+                endif()
+            endif()
+        endif()
+    endforeach()
+
+    if(NOT FOUND)
+        list(APPEND ERRORS "function not found")
+    elseif(NOT BUDGET STREQUAL "" AND COUNT GREATER BUDGET)
+        list(APPEND ERRORS "${COUNT} instructions, budget ${BUDGET}")
+    endif()
+    if(ERRORS)
+        set(FAILED TRUE)
+        message(STATUS "${FUNC}: FAILED ${ERRORS}")
+    elseif(BUDGET STREQUAL "")
+        message(STATUS "${FUNC}: ${COUNT} instructions, no budget")
+    else()
+        message(STATUS "${FUNC}: ${COUNT}/${BUDGET} instructions")
+    endif()
+endforeach()
+
+if(FAILED)
+    message(FATAL_ERROR "codegen check failed")
+endif()
@@ -0,0 +1,118 @@
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#include "unformatter/bit_unformatter.hpp"
+#include "unformatter/struct.hpp"
+#include "unformatter/unformatter.hpp"
+
+// Every function is checked by check_codegen.cmake, keep names in sync
+// with the budgets in CMakeLists.txt.
+
+using Header = unformatter::UnformatterStatic<std::byte, 8>;
+using AlignedBlock = unformatter::UnformatterStatic<std::byte, 16, 16>;
+using Column = unformatter::UnformatterStatic<std::uint32_t, 4, 16>;
+using IPv6Block = unformatter::UnformatterStatic<const std::byte, 40>;
+using Packet = unformatter::UnformatterDynamic<const std::byte>;
+
+struct IPv6Header
+{
+    std::uint32_t versionClassLabel;
+    std::uint16_t payloadLength;
+    std::uint8_t nextHeader;
+    std::uint8_t hopLimit;
+    std::array<std::byte, 16> src;
+    std::array<std::byte, 16> dst;
+};
+
+using IPv6HeaderLayout = unformatter::StructLayout<
+    IPv6Header,
+    unformatter::StructField<&IPv6Header::versionClassLabel, 0,
+                             std::endian::big>,
+    unformatter::StructField<&IPv6Header::payloadLength, 4, std::endian::big>,
+    unformatter::StructField<&IPv6Header::nextHeader, 6>,
+    unformatter::StructField<&IPv6Header::hopLimit, 7>,
+    unformatter::StructField<&IPv6Header::src, 8>,
+    unformatter::StructField<&IPv6Header::dst, 24>>;
+
+extern "C"
+{
+void codegenWriteByte(const Header header)
+{
+    header.subs<2, 1>().write<std::endian::big, std::uint8_t>(64);
+}
+
+std::uint32_t codegenReadBig32(const Header header)
+{
+    return header.subs<4, 4>().read<std::uint32_t, std::endian::big>();
+}
+
+std::uint32_t codegenReadUncheckedBig32(const Packet packet,
+                                        const std::size_t offset)
+{
+    return packet.subsUnchecked<unformatter::Unchecked>(offset, 4)
+        .readUnchecked<std::uint32_t, std::endian::big,
+                       unformatter::Unchecked>();
+}
+
+void codegenWriteBig16(const Header header, const std::uint16_t value)
+{
+    header.subs<0, 2>().write<std::endian::big>(value);
+}
+
+void codegenWriteRepr4(const Header header)
+{
+    unformatter::createBit(header).subs<4, 4>().writeRepr<6>();
+}
+
+void codegenReadAlignedColumn(const AlignedBlock block,
+                              const Column column)
+{
+    block.readCollection(column);
+}
+
+void codegenReadIPv6Header(const IPv6Block block, IPv6Header *header)
+{
+    *header = unformatter::readStruct<IPv6HeaderLayout>(block);
+}
+
+bool codegenEqualAddress(const IPv6Block left, const IPv6Block right)
+{
+    return left.subs<8, 16>() == right.subs<8, 16>();
+}
+
+bool codegenEqualHeader(const IPv6Block left, const IPv6Block right)
+{
+    return left == right;
+}
+
+bool codegenWriteFields(const Header header, const std::uint32_t flow)
+{
+    return unformatter::createBit(header)
+        .subs<0, 32>()
+        .writeFields<4, 8, 20>(6, 0, flow);
+}
+
+std::uint64_t codegenReadFields(const Header header)
+{
+    const auto [version, traffic, flow] =
+        unformatter::createBit(header).subs<0, 32>().readFields<4, 8, 20>();
+    return version + traffic + flow;
+}
+
+std::uint32_t codegenReadBig24(const Header header)
+{
+    return header.subs<1, 3>().readInteger<std::uint32_t, std::endian::big>();
+}
+
+std::int64_t codegenReadSignedBig48(const Header header)
+{
+    return header.subs<2, 6>().readInteger<std::int64_t, std::endian::big>();
+}
+
+void codegenWriteBig24(const Header header, const std::uint32_t value)
+{
+    header.subs<1, 3>().writeInteger<std::endian::big>(value);
+}
+}
@@ -0,0 +1,92 @@
+# Generates layouts of increasing field counts and reports the time and the
+# memory the compiler takes for each.
+#
+# COMPILER - C++ compiler executable
+# COMPILER_ID - CMAKE_CXX_COMPILER_ID of the compiler
+# INCLUDES - unformatter include directory
+# WORK_DIR - directory of the generated sources
+# FIELD_COUNTS - comma separated field counts
+# SPLIT_MAX_FIELDS - largest field count compiled with util::split
+#
+# Every layout is a buffer of 4 byte fields, described with util::split,
+# util::visitSplit and a subs per field. The std::tuple returned by
+# util::split grows superlinearly in the standard library, so it is skipped
+# above SPLIT_MAX_FIELDS. Memory is reported for GCC only, from
+# -ftime-report.
+
+# The standard library tuple of a 1000 field split nests deeper than the
+# default template depth.
+set(FLAGS -std=c++20 -O2 -ftemplate-depth=2048 "-I${INCLUDES}" -c)
+if(COMPILER_ID STREQUAL "GNU")
+    list(APPEND FLAGS -ftime-report)
+endif()
+
+string(REPLACE "," ";" FIELD_COUNTS "${FIELD_COUNTS}")
+foreach(FIELDS ${FIELD_COUNTS})
+    math(EXPR LAST "${FIELDS} - 1")
+    set(OFFSETS "")
+    set(SUBS "")
+    foreach(IDX RANGE 1 ${LAST})
+        math(EXPR OFFSET "${IDX} * 4")
+        string(APPEND OFFSETS ", ${OFFSET}")
+    endforeach()
+    foreach(IDX RANGE 0 ${LAST})
+        math(EXPR OFFSET "${IDX} * 4")
+        string(APPEND SUBS
+            "    sum += layout.subs<${OFFSET}, 4>()"
+            ".read<std::uint32_t, std::endian::big>();\n")
+    endforeach()
+    string(SUBSTRING "${OFFSETS}" 2 -1 OFFSETS)
+    math(EXPR SIZE "${FIELDS} * 4")
+
+    string(CONCAT PRELUDE
+        "#include <bit>\n#include <cstddef>\n#include <cstdint>\n"
+        "#include <tuple>\n\n#include \"unformatter/unformatter.hpp\"\n"
+        "#include \"unformatter/util.hpp\"\n\n"
+        "using Layout = unformatter::UnformatterStatic<const std::byte, "
+        "${SIZE}>;\n\n")
+    string(CONCAT SPLIT_BODY
+        "std::uint32_t sum(const Layout layout)\n{\n"
+        "    return std::apply([](const auto... fields) {\n"
+        "        return (std::uint32_t{0} + ... + fields.template read<"
+        "std::uint32_t, std::endian::big>());\n"
+        "    }, unformatter::util::split<${OFFSETS}>(layout));\n}\n")
+    string(CONCAT VISIT_BODY
+        "std::uint32_t sum(const Layout layout)\n{\n"
+        "    return unformatter::util::visitSplit<${OFFSETS}>(layout,\n"
+        "        [](const auto... fields) {\n"
+        "            return (std::uint32_t{0} + ... + fields.template read<"
+        "std::uint32_t, std::endian::big>());\n"
+        "        });\n}\n")
+    string(CONCAT SUBS_BODY
+        "std::uint32_t sum(const Layout layout)\n{\n"
+        "    std::uint32_t sum = 0;\n${SUBS}    return sum;\n}\n")
+
+    set(KINDS visit subs)
+    if(FIELDS LESS_EQUAL SPLIT_MAX_FIELDS)
+        list(PREPEND KINDS split)
+    endif()
+    foreach(KIND ${KINDS})
+        string(TOUPPER "${KIND}_BODY" BODY)
+        set(SOURCE "${WORK_DIR}/${KIND}_${FIELDS}.cpp")
+        string(CONCAT CONTENT "${PRELUDE}" "${${BODY}}")
+        file(WRITE "${SOURCE}" "${CONTENT}")
+
+        string(TIMESTAMP START "%s%f")
+        execute_process(COMMAND "${COMPILER}" ${FLAGS} "${SOURCE}"
+                -o "${WORK_DIR}/${KIND}_${FIELDS}.o"
+            RESULT_VARIABLE RES
+            ERROR_VARIABLE REPORT)
+        string(TIMESTAMP END "%s%f")
+        if(NOT RES EQUAL 0)
+            message(FATAL_ERROR "compiling ${SOURCE} failed:\n${REPORT}")
+        endif()
+        math(EXPR MILLISECONDS "(${END} - ${START}) / 1000")
+
+        set(MEMORY "")
+        if(REPORT MATCHES "TOTAL[^\n]* ([0-9]+[kMG])")
+            set(MEMORY ", ${CMAKE_MATCH_1} memory")
+        endif()
+        message(STATUS "${KIND} ${FIELDS} fields: ${MILLISECONDS} ms${MEMORY}")
+    endforeach()
+endforeach()
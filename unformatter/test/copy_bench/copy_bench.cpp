@@ -0,0 +1,179 @@
+// Times the copy tiers of writeCollection across sizes: constant size moves
+// for static sizes, memmove for dynamic ones and non-temporal stores from
+// UNFORMATTER_STREAMING_COPY_THRESHOLD up. Every size is also copied with
+// plain memmove and with writeCollectionStreaming, followed by a read of a
+// hot working set. Streaming is slower than memmove while the copy fits in
+// the cache, it pays off once a cached copy evicts the hot set, which
+// shows as the hot set read time of memmove growing. The threshold belongs
+// near that size, a fraction of the last level cache.
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <span>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+#include "unformatter/unformatter.hpp"
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t MIN_SIZE = 64;
+constexpr std::size_t MAX_SIZE = std::size_t{64} << 20;
+constexpr std::size_t BYTES_PER_SIZE = std::size_t{256} << 20;
+constexpr std::size_t BYTES_PER_ROUND = std::size_t{64} << 10;
+constexpr std::size_t MAX_ROUNDS = 4096;
+constexpr std::size_t HOT_SIZE = std::size_t{256} << 10;
+constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+// Keeps the compiler from dropping copies nobody reads.
+void clobber(const void *const ptr)
+{
+#if defined(__GNUC__)
+    asm volatile("" : : "r"(ptr) : "memory");
+#else
+    static_cast<void>(ptr);
+#endif
+}
+
+struct Result
+{
+    double gbPerSecond;
+    double hotNanoseconds;
+};
+
+// Copies size bytes repeatedly and reads the hot set after each round of
+// copies, the two are timed apart. A round copies at least BYTES_PER_ROUND,
+// so small copies aren't drowned by the clock.
+template<typename Copy>
+Result measure(const std::size_t size, std::vector<std::byte> &hot,
+               const Copy &copy)
+{
+    const auto copies = std::max<std::size_t>(BYTES_PER_ROUND / size, 1);
+    const auto rounds = std::clamp<std::size_t>(
+        BYTES_PER_SIZE / (size * copies), 16, MAX_ROUNDS);
+    Clock::duration copyTime{};
+    Clock::duration hotTime{};
+    std::uint64_t sum = 0;
+    for(std::size_t round = 0; round < rounds; ++round)
+    {
+        const auto start = Clock::now();
+        for(std::size_t idx = 0; idx < copies; ++idx)
+        {
+            copy();
+        }
+        const auto copied = Clock::now();
+        for(std::size_t pos = 0; pos < hot.size(); pos += CACHE_LINE_SIZE)
+        {
+            sum += std::to_integer<std::uint64_t>(hot[pos]);
+        }
+        clobber(&sum);
+        hotTime += Clock::now() - copied;
+        copyTime += copied - start;
+    }
+    const auto seconds = std::chrono::duration<double>(copyTime).count();
+    return {static_cast<double>(size * copies * rounds) / seconds / 1e9,
+            std::chrono::duration<double, std::nano>(hotTime).count() /
+                static_cast<double>(rounds)};
+}
+
+std::size_t lastLevelCacheSize()
+{
+#if defined(__linux__) && defined(_SC_LEVEL3_CACHE_SIZE)
+    if(const auto size = ::sysconf(_SC_LEVEL3_CACHE_SIZE); size > 0)
+    {
+        return static_cast<std::size_t>(size);
+    }
+#endif
+#if defined(__linux__) && defined(_SC_LEVEL2_CACHE_SIZE)
+    if(const auto size = ::sysconf(_SC_LEVEL2_CACHE_SIZE); size > 0)
+    {
+        return static_cast<std::size_t>(size);
+    }
+#endif
+    return 0;
+}
+
+template<std::size_t Size>
+void staticRow(std::vector<std::byte> &hot)
+{
+    std::vector<std::byte> src(Size, std::byte{1});
+    std::vector<std::byte> dst(Size);
+    const auto srcUnfmt = *unformatter::create<Size>(std::as_const(src));
+    const auto dstUnfmt = *unformatter::create<Size>(dst);
+    const auto dynSrc = unformatter::UnformatterDynamic<const std::byte>(
+        std::span<const std::byte>(src));
+    const auto dynDst =
+        unformatter::UnformatterDynamic<std::byte>(std::span(dst));
+    const auto staticRes = measure(Size, hot, [&] {
+        clobber(src.data());
+        static_cast<void>(dstUnfmt.writeCollection(srcUnfmt));
+        clobber(dst.data());
+    });
+    const auto dynamicRes = measure(Size, hot, [&] {
+        clobber(src.data());
+        static_cast<void>(dynDst.writeCollection(dynSrc));
+        clobber(dst.data());
+    });
+    std::printf("%10zu %12.2f %12.2f\n", Size, staticRes.gbPerSecond,
+                dynamicRes.gbPerSecond);
+}
+}
+
+int main()
+{
+    std::vector<std::byte> hot(HOT_SIZE, std::byte{1});
+    std::printf("streaming threshold: %zu bytes\n",
+                unformatter::inner::copy::STREAMING_THRESHOLD);
+    if(const auto llc = lastLevelCacheSize(); llc != 0)
+    {
+        std::printf("last level cache: %zu bytes\n", llc);
+    }
+    std::printf("hot set: %zu bytes\n\n", HOT_SIZE);
+
+    std::printf("static tier, GB/s\n%10s %12s %12s\n", "bytes", "static",
+                "dynamic");
+    [&]<std::size_t... Sizes>(std::index_sequence<Sizes...>) {
+        (staticRow<Sizes>(hot), ...);
+    }(std::index_sequence<16, 64, 256, 1024, 4096>{});
+
+    std::printf("\ndynamic tiers, GB/s and ns to read the hot set after a "
+                "round of copies\n%10s %10s %10s %10s %10s %10s %10s\n",
+                "bytes", "default", "memmove", "stream", "hot dflt",
+                "hot mmove", "hot strm");
+    for(auto size = MIN_SIZE; size <= MAX_SIZE; size *= 4)
+    {
+        std::vector<std::byte> src(size, std::byte{1});
+        std::vector<std::byte> dst(size);
+        const auto srcUnfmt = unformatter::UnformatterDynamic<const std::byte>(
+            std::span<const std::byte>(src));
+        const auto dstUnfmt =
+            unformatter::UnformatterDynamic<std::byte>(std::span(dst));
+        const auto defaultRes = measure(size, hot, [&] {
+            static_cast<void>(dstUnfmt.writeCollection(srcUnfmt));
+            clobber(dst.data());
+        });
+        const auto memmoveRes = measure(size, hot, [&] {
+            std::memmove(dst.data(), src.data(), size);
+            clobber(dst.data());
+        });
+        const auto streamRes = measure(size, hot, [&] {
+            static_cast<void>(dstUnfmt.writeCollectionStreaming(srcUnfmt));
+            clobber(dst.data());
+        });
+        std::printf("%10zu %10.2f %10.2f %10.2f %10.0f %10.0f %10.0f\n", size,
+                    defaultRes.gbPerSecond, memmoveRes.gbPerSecond,
+                    streamRes.gbPerSecond, defaultRes.hotNanoseconds,
+                    memmoveRes.hotNanoseconds, streamRes.hotNanoseconds);
+    }
+    return 0;
+}
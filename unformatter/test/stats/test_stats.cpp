@@ -0,0 +1,60 @@
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "unformatter/bit_unformatter.hpp"
+#include "unformatter/stats.hpp"
+#include "unformatter/unformatter.hpp"
+
+static_assert(std::is_same_v<unformatter::stats::Policy,
+                             unformatter::stats::ThreadLocalStats>);
+
+TEST_CASE("stats bounds failures", "[stats]")
+{
+    unformatter::stats::reset();
+    std::array<std::byte, 4> buf{};
+    REQUIRE_FALSE(unformatter::create<8>(buf));
+    const unformatter::UnformatterDynamic<std::byte> bufUnfmt(buf);
+    REQUIRE_FALSE(bufUnfmt.subs(5));
+    REQUIRE_FALSE(bufUnfmt.subs(2, 3));
+    REQUIRE_FALSE(bufUnfmt.read<std::uint16_t>());
+    const auto counters = unformatter::stats::snapshot();
+    REQUIRE(counters.boundsFailure(unformatter::stats::Site::create) == 1);
+    REQUIRE(counters.boundsFailure(unformatter::stats::Site::subs) == 2);
+    REQUIRE(counters.boundsFailure(unformatter::stats::Site::read) == 1);
+    REQUIRE(counters.boundsFailure(unformatter::stats::Site::write) == 0);
+    unformatter::stats::reset();
+    REQUIRE(unformatter::stats::snapshot().boundsFailure(
+                unformatter::stats::Site::subs) == 0);
+}
+
+TEST_CASE("stats copies", "[stats]")
+{
+    unformatter::stats::reset();
+    std::array<std::byte, 8> buf{};
+    const auto bufUnfmt = *unformatter::create<8>(buf);
+    bufUnfmt.subs<0, 4>().write<std::endian::native>(std::uint32_t{1});
+    constexpr auto NON_NATIVE = std::endian::native == std::endian::little
+                                    ? std::endian::big
+                                    : std::endian::little;
+    std::array<std::uint16_t, 2> values{1, 2};
+    bufUnfmt.subs<4, 4>().writeCollection<NON_NATIVE>(
+        *unformatter::create<2>(values));
+    {
+        const auto counters = unformatter::stats::snapshot();
+        REQUIRE(counters.byteCopies == 2);
+        REQUIRE(counters.bytesCopied == 8);
+        REQUIRE(counters.endianSwaps == 2);
+    }
+    const auto bitUnfmt = unformatter::createBit(bufUnfmt);
+    bitUnfmt.subs<3, 5>().writeRepr<0b101>();
+    {
+        const auto counters = unformatter::stats::snapshot();
+        REQUIRE(counters.bitCopies == 1);
+        REQUIRE(counters.bitsCopied == 5);
+        REQUIRE(counters.unalignedBitCopies == 1);
+    }
+}
@@ -4,6 +4,10 @@
 #include <climits>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <optional>
+#include <tuple>
+#include <utility>
 
 #include <catch2/catch_test_macros.hpp>
 
@@ -108,3 +112,325 @@ TEST_CASE("bit unformatter from unformatter", "[bit_unformatter]")
                           }));
     }
 }
+
+namespace
+{
+constexpr auto encodeBits()
+{
+    std::array<std::byte, 4> buf{};
+    const auto bitUnfmt =
+        unformatter::createBit(*unformatter::create<buf.size()>(buf));
+    bitUnfmt.subs<0, 4>().writeRepr<6>();
+    [[maybe_unused]] const auto res = bitUnfmt.subs(4, 8)->writeRepr(0xab);
+    const std::byte flow{0b10110};
+    bitUnfmt.subs<27, 5>().writeCollection(
+        unformatter::createBit(flow).subs<3, 5>());
+    return buf;
+}
+
+static_assert(encodeBits() == std::to_array<std::byte>({
+                                  std::byte{0x6a},
+                                  std::byte{0xb0},
+                                  std::byte{0x00},
+                                  std::byte{0x16},
+                              }));
+
+constexpr auto readWriteBits()
+{
+    auto buf = std::to_array<std::byte>({std::byte{0xf0}, std::byte{0x0f}});
+    const auto bitUnfmt = unformatter::createBit(buf);
+    std::byte value{};
+    [[maybe_unused]] const auto readRes = bitUnfmt.subs(4, 8)->read(value);
+    [[maybe_unused]] const auto writeRes =
+        bitUnfmt.subs(0, 8)->write(std::byte{0x5a});
+    return std::tuple{value, buf};
+}
+
+static_assert(readWriteBits() ==
+              std::tuple{std::byte{0x00},
+                         std::to_array<std::byte>(
+                             {std::byte{0x5a}, std::byte{0x0f}})});
+
+constexpr auto xorShifted()
+{
+    std::array<std::byte, 12> buf{};
+    for(std::size_t idx = 0; idx < buf.size(); ++idx)
+    {
+        buf[idx] = std::byte(0x11 * (idx + 1));
+    }
+    const auto bitUnfmt = unformatter::createBit(buf);
+    bitUnfmt.subs<8, 80>().xorWith(bitUnfmt.subs<0, 80>());
+    return buf;
+}
+
+static_assert(xorShifted() ==
+              std::to_array<std::byte>(
+                  {std::byte{0x11}, std::byte{0x33}, std::byte{0x11},
+                   std::byte{0x77}, std::byte{0x11}, std::byte{0x33},
+                   std::byte{0x11}, std::byte{0xff}, std::byte{0x11},
+                   std::byte{0x33}, std::byte{0x11}, std::byte{0xcc}}));
+}
+
+TEST_CASE("bit unformatter equality", "[bit_unformatter]")
+{
+    const auto data =
+        std::to_array<std::uint8_t>({0b10110010, 0b01011001, 0b10000000});
+    const auto dataUnfmt = unformatter::createBit(data);
+    REQUIRE(*dataUnfmt.subs(0, 7) == *dataUnfmt.subs(9, 7));
+    REQUIRE_FALSE(*dataUnfmt.subs(0, 8) == *dataUnfmt.subs(9, 8));
+    REQUIRE_FALSE(*dataUnfmt.subs(0, 7) == *dataUnfmt.subs(9, 6));
+    REQUIRE(dataUnfmt.subs<0, 3>() == dataUnfmt.subs<9, 3>());
+
+    std::array<std::uint8_t, 17> left{};
+    std::array<std::uint8_t, 18> right{};
+    for(std::size_t idx = 0; idx < left.size(); ++idx)
+    {
+        left[idx] = static_cast<std::uint8_t>(idx * 37);
+    }
+    const auto rightUnfmt = unformatter::createBit(right);
+    REQUIRE(rightUnfmt.subs(5, left.size() * CHAR_BIT)
+                ->writeCollection(unformatter::createBit(left)));
+    REQUIRE(*rightUnfmt.subs(5, left.size() * CHAR_BIT) ==
+            unformatter::createBit(left));
+    REQUIRE_FALSE(*rightUnfmt.subs(4, left.size() * CHAR_BIT) ==
+                  unformatter::createBit(left));
+    std::size_t words = 0;
+    std::size_t bits = 0;
+    unformatter::createBit(left).visitWords(
+        [&](std::uint64_t, const std::size_t wordBits) {
+            ++words;
+            bits += wordBits;
+        });
+    REQUIRE(words == 3);
+    REQUIRE(bits == left.size() * CHAR_BIT);
+}
+
+TEST_CASE("bit unformatter fields", "[bit_unformatter]")
+{
+    std::array<std::uint8_t, 5> data{};
+    data.fill(0xff);
+    const auto dataUnfmt = unformatter::createBit(data);
+    const auto groupUnfmt = dataUnfmt.subs<3, 32>();
+    REQUIRE(groupUnfmt.writeFields<4, 8, 20>(6, 0, 0xdead));
+    REQUIRE(data == std::to_array<std::uint8_t>(
+                        {0b11101100, 0b00000000, 0b00011011, 0b11010101,
+                         0b10111111}));
+    const auto [version, traffic, flow] =
+        groupUnfmt.readFields<4, 8, 20>();
+    REQUIRE(version == 6);
+    REQUIRE(traffic == 0);
+    REQUIRE(flow == 0xdead);
+    REQUIRE_FALSE(groupUnfmt.writeFields<4, 8, 20>(16, 0, 0));
+    REQUIRE_FALSE(groupUnfmt.writeFields<4, 8, 20>(-1, 0, 0));
+    REQUIRE(groupUnfmt.readFields<4, 8, 20>() ==
+            std::to_array<std::uint64_t>({6, 0, 0xdead}));
+
+    std::uint64_t word{};
+    const auto wordUnfmt = unformatter::createBit(word);
+    REQUIRE(wordUnfmt.writeFields<1, 63>(1, 0x123456789));
+    REQUIRE(wordUnfmt.readFields<64>()[0] == 0x8000000123456789);
+    REQUIRE(wordUnfmt.readFields<1, 63>() ==
+            std::to_array<std::uint64_t>({1, 0x123456789}));
+}
+
+TEST_CASE("bit unformatter scanning", "[bit_unformatter]")
+{
+    std::array<std::uint8_t, 300> data{};
+    const auto dataUnfmt = unformatter::createBit(data);
+    const auto range = *dataUnfmt.subs(3, 2389);
+    REQUIRE(range.countOnes() == 0);
+    REQUIRE_FALSE(range.findFirstSet().has_value());
+    REQUIRE(range.findFirstClear(17) == 17);
+    REQUIRE(range.countLeadingZeros() == range.size());
+
+    data[0] = 0b11100000;
+    data.back() = 0xff;
+    REQUIRE(range.countOnes() == 0);
+    data[0] = 0b11110000;
+    data[100] = 0b00100001;
+    data[298] = 0b00000011;
+    REQUIRE(range.countOnes() == 5);
+    REQUIRE(range.findFirstSet() == 0);
+    REQUIRE(range.findFirstSet(1) == 100 * CHAR_BIT + 2 - 3);
+    REQUIRE(range.findFirstSet(100 * CHAR_BIT) == 100 * CHAR_BIT + 7 - 3);
+    REQUIRE(range.findFirstSet(100 * CHAR_BIT + 5) == 298 * CHAR_BIT + 6 - 3);
+    REQUIRE(range.findFirstSet(298 * CHAR_BIT + 7 - 3) == range.size() - 1);
+    REQUIRE_FALSE(range.findFirstSet(range.size()).has_value());
+    REQUIRE(range.subs(1)->countLeadingZeros() == 100 * CHAR_BIT + 1 - 3);
+    REQUIRE(range.subsUnchecked(1).countLeadingZeros() ==
+            100 * CHAR_BIT + 1 - 3);
+    REQUIRE(range.subsUnchecked<unformatter::Unchecked>(0, 1).countOnes() == 1);
+
+    std::ranges::fill(data, 0xff);
+    REQUIRE(range.countOnes() == range.size());
+    REQUIRE_FALSE(range.findFirstClear().has_value());
+    data[200] = 0xfe;
+    REQUIRE(range.countOnes() == range.size() - 1);
+    REQUIRE(range.findFirstClear(5) == 200 * CHAR_BIT + 7 - 3);
+    REQUIRE(unformatter::createBit(data).subs<1605, 3>().countOnes() == 2);
+}
+
+TEST_CASE("bit unformatter bitwise operations", "[bit_unformatter]")
+{
+    const auto bitAt = [](const auto &bytes, const std::size_t pos) {
+        return (bytes[pos / CHAR_BIT] >> (CHAR_BIT - 1 - pos % CHAR_BIT)) & 1;
+    };
+    std::array<std::uint8_t, 40> left{};
+    std::array<std::uint8_t, 40> right{};
+    for(std::size_t idx = 0; idx < left.size(); ++idx)
+    {
+        left[idx] = static_cast<std::uint8_t>(idx * 37 + 11);
+        right[idx] = static_cast<std::uint8_t>(idx * 91 + 5);
+    }
+    const auto rightUnfmt = unformatter::createBit(std::as_const(right));
+    for(const auto &[dstOffset, srcOffset, size] :
+        std::to_array<std::tuple<std::size_t, std::size_t, std::size_t>>(
+            {{0, 0, 320}, {3, 3, 5}, {5, 5, 150}, {1, 6, 3}, {7, 2, 200},
+             {4, 13, 139}, {13, 0, 64}, {0, 9, 303}}))
+    {
+        auto result = left;
+        const auto dst = *unformatter::createBit(result).subs(dstOffset, size);
+        const auto src = *rightUnfmt.subs(srcOffset, size);
+        REQUIRE(dst.xorWith(src));
+        REQUIRE(dst.andWith(*dst.subs(0)));
+        for(std::size_t pos = 0; pos < left.size() * CHAR_BIT; ++pos)
+        {
+            const auto inside = pos >= dstOffset && pos < dstOffset + size;
+            const auto expected =
+                inside ? bitAt(left, pos) ^
+                             bitAt(right, srcOffset + pos - dstOffset)
+                       : bitAt(left, pos);
+            REQUIRE(bitAt(result, pos) == expected);
+        }
+        dst.invert();
+        REQUIRE(dst.orWith(src));
+        for(std::size_t pos = 0; pos < size; ++pos)
+        {
+            const auto srcBit = bitAt(right, srcOffset + pos);
+            REQUIRE(bitAt(result, dstOffset + pos) ==
+                    ((bitAt(left, dstOffset + pos) ^ srcBit ^ 1) | srcBit));
+        }
+    }
+
+    std::array<std::uint8_t, 2> value{0x0f, 0xf0};
+    const auto valueUnfmt = unformatter::createBit(value);
+    REQUIRE_FALSE(valueUnfmt.andWith(*rightUnfmt.subs(0, 15)));
+    valueUnfmt.andWith(unformatter::createBit(std::as_const(value)));
+    valueUnfmt.subs<4, 8>().xorWith(rightUnfmt.subs<0, 8>());
+    REQUIRE(value == std::array<std::uint8_t, 2>{
+                         static_cast<std::uint8_t>(0x0f ^ (right[0] >> 4)),
+                         static_cast<std::uint8_t>(0xf0 ^ (right[0] << 4))});
+}
+
+TEST_CASE("bit unformatter overlapping operations", "[bit_unformatter]")
+{
+    const auto bitAt = [](const auto &bytes, const std::size_t pos) {
+        return (bytes[pos / CHAR_BIT] >> (CHAR_BIT - 1 - pos % CHAR_BIT)) & 1;
+    };
+    constexpr std::size_t SIZE = 600;
+    std::array<std::uint8_t, 96> initial{};
+    for(std::size_t idx = 0; idx < initial.size(); ++idx)
+    {
+        initial[idx] = static_cast<std::uint8_t>(idx * 73 + 29);
+    }
+    const auto check = [&](const std::size_t dstOffset,
+                           const std::size_t srcOffset, const auto &apply,
+                           const auto &op) {
+        auto data = initial;
+        const auto unfmt = unformatter::createBit(data);
+        REQUIRE(apply(*unfmt.subs(dstOffset, SIZE),
+                      *unfmt.subs(srcOffset, SIZE)));
+        for(std::size_t pos = 0; pos < data.size() * CHAR_BIT; ++pos)
+        {
+            const auto inside = pos >= dstOffset && pos < dstOffset + SIZE;
+            const auto expected =
+                inside ? op(bitAt(initial, pos),
+                            bitAt(initial, srcOffset + pos - dstOffset))
+                       : bitAt(initial, pos);
+            REQUIRE(bitAt(data, pos) == expected);
+        }
+    };
+    for(const std::size_t shift : {1, 5, 8, 13, 64, 67})
+    {
+        for(const auto &[dstOffset, srcOffset] :
+            {std::pair{shift, std::size_t{0}}, std::pair{std::size_t{0}, shift}})
+        {
+            check(
+                dstOffset, srcOffset,
+                [](const auto &dst, const auto &src) { return dst.xorWith(src); },
+                std::bit_xor<>{});
+            check(
+                dstOffset, srcOffset,
+                [](const auto &dst, const auto &src) { return dst.andWith(src); },
+                std::bit_and<>{});
+            check(
+                dstOffset, srcOffset,
+                [](const auto &dst, const auto &src) { return dst.orWith(src); },
+                std::bit_or<>{});
+        }
+    }
+}
+
+TEST_CASE("bit unformatter pattern search", "[bit_unformatter]")
+{
+    std::array<std::uint8_t, 300> data{};
+    std::uint32_t state = 1;
+    for(auto &val : data)
+    {
+        state = state * 1103515245 + 12345;
+        val = static_cast<std::uint8_t>(state >> 16);
+    }
+    const auto bitAt = [&](const std::size_t pos) -> std::uint64_t {
+        return data[pos / CHAR_BIT] >> (CHAR_BIT - 1 - pos % CHAR_BIT) & 1;
+    };
+    const auto dataUnfmt = unformatter::createBit(data);
+    const auto range = *dataUnfmt.subs(5, 2390);
+    for(const std::size_t patternBits : {1U, 7U, 13U, 32U, 56U, 57U, 64U})
+    {
+        for(const std::size_t start :
+            {std::size_t{0}, std::size_t{3}, std::size_t{811},
+             2390 - patternBits})
+        {
+            std::uint64_t pattern = 0;
+            for(std::size_t idx = 0; idx < patternBits; ++idx)
+            {
+                pattern = pattern << 1 | bitAt(5 + start + idx);
+            }
+            std::optional<std::size_t> expected;
+            for(std::size_t pos = 0; !expected && pos + patternBits <= 2390;
+                ++pos)
+            {
+                std::uint64_t window = 0;
+                for(std::size_t idx = 0; idx < patternBits; ++idx)
+                {
+                    window = window << 1 | bitAt(5 + pos + idx);
+                }
+                if(window == pattern)
+                {
+                    expected = pos;
+                }
+            }
+            REQUIRE(expected <= start);
+            REQUIRE(range.findPattern(pattern, patternBits) == expected);
+            REQUIRE(range.findPattern(pattern, patternBits, *expected) ==
+                    expected);
+            REQUIRE(range.subs(start)->findPattern(pattern, patternBits) ==
+                    0);
+            REQUIRE_FALSE(range.subs(start, patternBits - 1)
+                              ->findPattern(pattern, patternBits)
+                              .has_value());
+        }
+    }
+
+    std::ranges::fill(data, 0);
+    REQUIRE_FALSE(range.findPattern(1, 1).has_value());
+    data[200] = 0b00000101;
+    data[201] = 0b11000000;
+    REQUIRE(range.findPattern(0b10111, 5) == 200 * CHAR_BIT + 5 - 5);
+    REQUIRE(range.findPattern(0b1110111, 5, 10) == 200 * CHAR_BIT + 5 - 5);
+    REQUIRE_FALSE(range.findPattern(0b10111, 5, 200 * CHAR_BIT + 1).has_value());
+    REQUIRE_FALSE(range.findPattern(0b10111, 0).has_value());
+    REQUIRE_FALSE(range.findPattern(0b10111, 65).has_value());
+    REQUIRE(unformatter::createBit(data).subs<1605, 5>().findPattern(
+                0b10111, 5) == 0);
+}
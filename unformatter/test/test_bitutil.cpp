@@ -1,3 +1,7 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
 #include "unformatter/inner/bitutil.hpp"
 
 using namespace unformatter::inner::bitutil;
@@ -15,4 +19,46 @@ static_assert(combineBits(std::byte{0b01010101}, 2, std::byte{0b10101010}) ==
               std::byte{0b01101010});
 static_assert(combineBits(std::byte{0b01010101}, 3, std::byte{0b10101010}, 5,
                           FULL_PATTERN) == std::byte{0b01001111});
+
+constexpr auto storeBitsPattern(const std::size_t offset,
+                                const std::size_t bits,
+                                const std::uint64_t value)
+{
+    std::array<std::byte, 10> data{};
+    data.fill(FULL_PATTERN);
+    storeBits(data, offset, bits, value);
+    return data;
+}
+static_assert(storeBitsPattern(5, 9, 0b000101010) ==
+              std::array<std::byte, 10>{
+                  std::byte{0b11111000}, std::byte{0b10101011}, FULL_PATTERN,
+                  FULL_PATTERN, FULL_PATTERN, FULL_PATTERN, FULL_PATTERN,
+                  FULL_PATTERN, FULL_PATTERN, FULL_PATTERN});
+static_assert(storeBitsPattern(3, 64, 0) ==
+              std::array<std::byte, 10>{
+                  std::byte{0b11100000}, std::byte{0}, std::byte{0},
+                  std::byte{0}, std::byte{0}, std::byte{0}, std::byte{0},
+                  std::byte{0}, std::byte{0b00011111}, FULL_PATTERN});
+
+constexpr std::array<std::byte, 10> LOAD_PATTERN{
+    std::byte{0b11111000}, std::byte{0b10101011}, std::byte{0x12},
+    std::byte{0x34},       std::byte{0x56},       std::byte{0x78},
+    std::byte{0x9a},       std::byte{0xbc},       std::byte{0xde},
+    std::byte{0xf0}};
+static_assert(loadBits(LOAD_PATTERN, 5, 9) == 0b000101010);
+static_assert(loadBits(LOAD_PATTERN, 0, 0) == 0);
+static_assert(loadBits(LOAD_PATTERN, 16, 64) == 0x123456789abcdef0);
+static_assert(loadBits(LOAD_PATTERN, 12, 64) == 0xb123456789abcdef);
+static_assert(loadBits<8>(LOAD_PATTERN, 7, 2) == 0b01);
+
+static_assert(countOnes(LOAD_PATTERN, 0, 0) == 0);
+static_assert(countOnes(LOAD_PATTERN, 3, 3) == 2);
+static_assert(countOnes(LOAD_PATTERN, 5, 9) == 3);
+static_assert(countOnes(LOAD_PATTERN, 0, 80) == 42);
+
+static_assert(!findFirst<true>(LOAD_PATTERN, 5, 3).has_value());
+static_assert(findFirst<true>(LOAD_PATTERN, 5, 4) == 3);
+static_assert(findFirst<false>(LOAD_PATTERN, 0, 80) == 5);
+static_assert(findFirst<false>(LOAD_PATTERN, 72, 8) == 4);
+static_assert(findFirst<true>(LOAD_PATTERN, 73, 7) == 0);
 }
@@ -0,0 +1,115 @@
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "unformatter/buffer_pool.hpp"
+
+TEST_CASE("buffer pool acquire release", "[buffer_pool]")
+{
+    using Pool = unformatter::BufferPool<40>;
+    STATIC_REQUIRE(
+        std::is_same_v<Pool::Buffer,
+                       unformatter::UnformatterStatic<std::byte, 40, 64>>);
+    REQUIRE_FALSE(Pool::create(0));
+    const auto pool = Pool::create(3);
+    REQUIRE(pool);
+    REQUIRE(pool->capacity() == 3);
+    std::vector<Pool::Buffer> buffers;
+    while(const auto maybeBuffer = pool->acquire())
+    {
+        REQUIRE(reinterpret_cast<std::uintptr_t>((**maybeBuffer).data()) %
+                    64 ==
+                0);
+        buffers.push_back(*maybeBuffer);
+    }
+    REQUIRE(buffers.size() == 3);
+    buffers[1].subs<0, 4>().write<std::endian::big, std::uint32_t>(0x60000000);
+    REQUIRE(buffers[1].subs<0, 1>().read<std::uint8_t>() == 0x60);
+    pool->release(buffers[1]);
+    const auto reacquired = pool->acquire();
+    REQUIRE(reacquired);
+    REQUIRE((**reacquired).data() == (*buffers[1]).data());
+    REQUIRE_FALSE(pool->acquire());
+}
+
+TEST_CASE("buffer pool cache", "[buffer_pool]")
+{
+    using Pool = unformatter::BufferPool<16, 16>;
+    const auto pool = Pool::create(4, {.hugePages = true});
+    REQUIRE(pool);
+    {
+        Pool::Cache cache(*pool);
+        const auto buffer = cache.acquire();
+        REQUIRE(buffer);
+        REQUIRE_FALSE(pool->acquire());
+        cache.release(*buffer);
+    }
+    std::set<const std::byte *> buffers;
+    while(const auto maybeBuffer = pool->acquire())
+    {
+        buffers.insert((**maybeBuffer).data());
+    }
+    REQUIRE(buffers.size() == 4);
+}
+
+TEST_CASE("buffer pool threads", "[buffer_pool]")
+{
+    using Pool = unformatter::BufferPool<64>;
+    constexpr std::size_t THREADS = 4;
+    constexpr std::size_t CAPACITY = 64;
+    constexpr std::size_t ROUNDS = 10000;
+    const auto pool = Pool::create(CAPACITY);
+    REQUIRE(pool);
+    std::vector<std::thread> threads;
+    std::vector<char> corrupted(THREADS);
+    for(std::size_t thr = 0; thr < THREADS; ++thr)
+    {
+        threads.emplace_back([&pool, &corrupted, thr] {
+            Pool::Cache cache(*pool);
+            for(std::size_t round = 0; round < ROUNDS; ++round)
+            {
+                const auto buffer = round % 2 == 0 ? cache.acquire()
+                                                   : pool->acquire();
+                if(!buffer)
+                {
+                    continue;
+                }
+                const auto value = static_cast<std::uint64_t>(thr);
+                buffer->subs<0, 8>().write(value);
+                std::this_thread::yield();
+                if(buffer->subs<0, 8>().read<std::uint64_t>() != value)
+                {
+                    corrupted[thr] = true;
+                }
+                if(round % 3 == 0)
+                {
+                    pool->release(*buffer);
+                }
+                else
+                {
+                    cache.release(*buffer);
+                }
+            }
+        });
+    }
+    for(auto &thread : threads)
+    {
+        thread.join();
+    }
+    for(std::size_t thr = 0; thr < THREADS; ++thr)
+    {
+        REQUIRE_FALSE(corrupted[thr]);
+    }
+    std::set<const std::byte *> buffers;
+    while(const auto maybeBuffer = pool->acquire())
+    {
+        buffers.insert((**maybeBuffer).data());
+    }
+    REQUIRE(buffers.size() == CAPACITY);
+}
@@ -0,0 +1,160 @@
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "unformatter/dispatch.hpp"
+#include "unformatter/unformatter.hpp"
+
+namespace
+{
+constexpr int unknown(const int value)
+{
+    return -value;
+}
+constexpr int tcp(const int value)
+{
+    return value + 6;
+}
+constexpr int udp(const int value)
+{
+    return value + 17;
+}
+constexpr int icmp(const int value)
+{
+    return value + 58;
+}
+
+enum class MessageType : std::uint16_t
+{
+    hello = 0x0001,
+    data = 0x1000,
+    ack = 0x8000,
+    close = 0xffff,
+};
+
+using NextHeaderTable = unformatter::DispatchTable<
+    &unknown, unformatter::DispatchCase<std::uint8_t{6}, &tcp>,
+    unformatter::DispatchCase<std::uint8_t{17}, &udp>,
+    unformatter::DispatchCase<std::uint8_t{58}, &icmp>>;
+
+using MessageTable = unformatter::DispatchTable<
+    &unknown, unformatter::DispatchCase<MessageType::hello, &tcp>,
+    unformatter::DispatchCase<MessageType::data, &udp>,
+    unformatter::DispatchCase<MessageType::ack, &icmp>,
+    unformatter::DispatchCase<MessageType::close, &unknown>>;
+
+using SignedTable = unformatter::DispatchTable<
+    &unknown, unformatter::DispatchCase<-2, &tcp>,
+    unformatter::DispatchCase<1, &udp>>;
+
+static_assert(!NextHeaderTable::dense);
+static_assert(NextHeaderTable::lookup(6) == &tcp);
+static_assert(NextHeaderTable::lookup(17) == &udp);
+static_assert(NextHeaderTable::lookup(58) == &icmp);
+static_assert(NextHeaderTable::lookup(7) == &unknown);
+static_assert(NextHeaderTable::lookup(255) == &unknown);
+
+static_assert(!MessageTable::dense);
+static_assert(MessageTable::lookup(MessageType::ack) == &icmp);
+static_assert(MessageTable::lookup(MessageType{2}) == &unknown);
+
+static_assert(SignedTable::dense);
+static_assert(SignedTable::lookup(-2) == &tcp);
+static_assert(SignedTable::lookup(1) == &udp);
+static_assert(SignedTable::lookup(0) == &unknown);
+static_assert(SignedTable::lookup(-3) == &unknown);
+static_assert(SignedTable::lookup(2) == &unknown);
+
+constexpr int dispatchPacket(const std::uint8_t nextHeader)
+{
+    std::array<std::byte, 8> buf{};
+    const auto bufUnfmt = *unformatter::create<buf.size()>(buf);
+    bufUnfmt.subs<6, 1>().write(nextHeader);
+    return unformatter::dispatch(bufUnfmt.subs<6, 1>(), NextHeaderTable{}, 1);
+}
+
+static_assert(dispatchPacket(17) == 18);
+static_assert(dispatchPacket(18) == -1);
+}
+
+TEST_CASE("dispatch dense", "[dispatch]")
+{
+    using Table = unformatter::DispatchTable<
+        &unknown, unformatter::DispatchCase<std::uint8_t{4}, &tcp>,
+        unformatter::DispatchCase<std::uint8_t{5}, &udp>,
+        unformatter::DispatchCase<std::uint8_t{7}, &icmp>>;
+    STATIC_REQUIRE(Table::dense);
+    for(unsigned int key = 0; key < 256; ++key)
+    {
+        const auto handler = Table::lookup(static_cast<std::uint8_t>(key));
+        REQUIRE(handler == (key == 4   ? &tcp
+                            : key == 5 ? &udp
+                            : key == 7 ? &icmp
+                                       : &unknown));
+    }
+}
+
+TEST_CASE("dispatch field", "[dispatch]")
+{
+    auto buf = std::to_array<std::uint8_t>({0x80, 0x00, 0x00, 0x02});
+    const auto bufUnfmt = *unformatter::create<buf.size()>(buf);
+    REQUIRE(unformatter::dispatch<std::endian::big>(bufUnfmt.subs<0, 2>(),
+                                                    MessageTable{}, 2) == 60);
+    REQUIRE(unformatter::dispatch<std::endian::big>(bufUnfmt.subs<2, 2>(),
+                                                    MessageTable{}, 2) == -2);
+    const unformatter::UnformatterDynamic<std::uint8_t> dynUnfmt(buf);
+    REQUIRE(unformatter::dispatch<std::endian::big>(*dynUnfmt.subs(0, 2),
+                                                    MessageTable{}, 3) == 61);
+    REQUIRE(unformatter::dispatch<std::endian::big>(*dynUnfmt.subs(0, 3),
+                                                    MessageTable{}, 3) == -3);
+}
+
+TEST_CASE("dispatch size", "[dispatch]")
+{
+    auto buf = std::to_array<std::uint8_t>(
+        {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a});
+    const unformatter::UnformatterDynamic<std::uint8_t> dynUnfmt(buf);
+    const auto sum = [](const auto unfmt) -> std::uint64_t {
+        using U = std::remove_const_t<decltype(unfmt)>;
+        if constexpr(std::same_as<U, unformatter::UnformatterStatic<
+                                         std::uint8_t, 2>>)
+        {
+            return unfmt.template read<std::uint16_t, std::endian::big>();
+        }
+        else if constexpr(std::same_as<U, unformatter::UnformatterStatic<
+                                              std::uint8_t, 4>>)
+        {
+            return unfmt.template read<std::uint32_t, std::endian::big>();
+        }
+        else if constexpr(std::same_as<U, unformatter::UnformatterStatic<
+                                              std::uint8_t, 8>>)
+        {
+            return unfmt.template read<std::uint64_t, std::endian::big>();
+        }
+        else
+        {
+            return 1000 + unfmt.size();
+        }
+    };
+    REQUIRE(unformatter::dispatchSize<4, 2, 8>(*dynUnfmt.subs(0, 2), sum) ==
+            0x0102);
+    REQUIRE(unformatter::dispatchSize<4, 2, 8>(*dynUnfmt.subs(1, 4), sum) ==
+            0x02030405);
+    REQUIRE(unformatter::dispatchSize<4, 2, 8>(*dynUnfmt.subs(2, 8), sum) ==
+            0x030405060708090a);
+    REQUIRE(unformatter::dispatchSize<4, 2, 8>(*dynUnfmt.subs(0, 0), sum) ==
+            1000);
+    REQUIRE(unformatter::dispatchSize<4, 2, 8>(*dynUnfmt.subs(0, 3), sum) ==
+            1003);
+    REQUIRE(unformatter::dispatchSize<4, 2, 8>(dynUnfmt, sum) == 1010);
+    STATIC_REQUIRE(unformatter::dispatchSize<2>(
+                       unformatter::UnformatterDynamic<const std::uint8_t>(
+                           std::span<const std::uint8_t>()),
+                       [](const auto unfmt) { return unfmt.size(); }) == 0);
+}
@@ -0,0 +1,214 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "unformatter/encoding.hpp"
+#include "unformatter/unformatter.hpp"
+
+namespace
+{
+constexpr bool hexRoundTrip()
+{
+    const auto bytes = std::to_array<std::uint8_t>({0x00, 0x9a, 0xf0, 0x5c});
+    std::array<char, unformatter::hexEncodedSize(bytes.size())> hex{};
+    unformatter::hexEncode(*unformatter::create<bytes.size()>(bytes),
+                           *unformatter::create<hex.size()>(hex));
+    std::array<std::uint8_t, bytes.size()> decoded{};
+    return std::string_view(hex.data(), hex.size()) == "009af05c" &&
+           unformatter::hexDecode(*unformatter::create<hex.size()>(hex),
+                                  *unformatter::create<decoded.size()>(
+                                      decoded)) &&
+           decoded == bytes;
+}
+static_assert(hexRoundTrip());
+
+constexpr bool base64RoundTrip()
+{
+    const auto bytes = std::to_array<std::uint8_t>({'f', 'o', 'o', 'b'});
+    std::array<char, unformatter::base64EncodedSize(bytes.size())> base64{};
+    unformatter::base64Encode(*unformatter::create<bytes.size()>(bytes),
+                              *unformatter::create<base64.size()>(base64));
+    std::array<std::uint8_t, bytes.size()> decoded{};
+    return std::string_view(base64.data(), base64.size()) == "Zm9vYg==" &&
+           unformatter::base64Decode(
+               *unformatter::create<base64.size()>(base64),
+               *unformatter::create<decoded.size()>(decoded)) &&
+           decoded == bytes;
+}
+static_assert(base64RoundTrip());
+
+// Encodings of the pattern in constant evaluation, which always takes the
+// scalar loops, to check the vector kernels against.
+constexpr auto PATTERN = [] {
+    std::array<std::uint8_t, 256> bytes{};
+    for(std::size_t idx = 0; idx < bytes.size(); ++idx)
+    {
+        bytes[idx] = static_cast<std::uint8_t>(idx * 167 + 13);
+    }
+    return bytes;
+}();
+
+constexpr auto PATTERN_HEX = [] {
+    std::array<char, unformatter::hexEncodedSize(PATTERN.size())> hex{};
+    unformatter::hexEncode(*unformatter::create<PATTERN.size()>(PATTERN),
+                           *unformatter::create<hex.size()>(hex));
+    return hex;
+}();
+
+constexpr auto PATTERN_BASE64 = [] {
+    std::array<char, unformatter::base64EncodedSize(PATTERN.size())> base64{};
+    unformatter::base64Encode(*unformatter::create<PATTERN.size()>(PATTERN),
+                              *unformatter::create<base64.size()>(base64));
+    return base64;
+}();
+
+std::string base64(const std::string_view text)
+{
+    std::string result(unformatter::base64EncodedSize(text.size()), '\0');
+    const auto res = unformatter::base64Encode(
+        unformatter::UnformatterDynamic<const std::uint8_t>(
+            std::span(reinterpret_cast<const std::uint8_t *>(text.data()),
+                      text.size())),
+        unformatter::UnformatterDynamic<char>(std::span(result)));
+    REQUIRE(res);
+    return result;
+}
+
+std::optional<std::string> unbase64(const std::string_view text,
+                                    const std::size_t size)
+{
+    std::string result(size, '\0');
+    std::span bytes(reinterpret_cast<std::uint8_t *>(result.data()), size);
+    if(!unformatter::base64Decode(
+           unformatter::UnformatterDynamic<const char>(text),
+           unformatter::UnformatterDynamic<std::uint8_t>(bytes)))
+    {
+        return std::nullopt;
+    }
+    return result;
+}
+}
+
+TEST_CASE("hex encode decode", "[encoding]")
+{
+    std::array<std::byte, 256> bytes{};
+    for(std::size_t idx = 0; idx < bytes.size(); ++idx)
+    {
+        bytes[idx] = static_cast<std::byte>(idx);
+    }
+    std::array<char, unformatter::hexEncodedSize(bytes.size())> hex{};
+    const unformatter::UnformatterDynamic<char> hexUnfmt(hex);
+    REQUIRE(unformatter::hexEncode(
+        unformatter::UnformatterDynamic<const std::byte>(bytes), hexUnfmt));
+    REQUIRE(std::string_view(hex.data(), 6) == "000102");
+    REQUIRE(std::string_view(hex.data() + 2 * 0xab, 2) == "ab");
+    REQUIRE_FALSE(unformatter::hexEncode(
+        unformatter::UnformatterDynamic<const std::byte>(bytes),
+        *hexUnfmt.subs(1)));
+
+    std::array<std::byte, bytes.size()> decoded{};
+    const unformatter::UnformatterDynamic<std::byte> decodedUnfmt(decoded);
+    REQUIRE(unformatter::hexDecode(hexUnfmt, decodedUnfmt));
+    REQUIRE(decoded == bytes);
+    REQUIRE_FALSE(unformatter::hexDecode(hexUnfmt, *decodedUnfmt.subs(1)));
+
+    std::array<std::uint8_t, 2> pair{};
+    const auto pairUnfmt = *unformatter::create<pair.size()>(pair);
+    REQUIRE(unformatter::hexDecode(
+        unformatter::UnformatterDynamic<const char>("C0fE"), pairUnfmt));
+    REQUIRE(pair == std::to_array<std::uint8_t>({0xc0, 0xfe}));
+    REQUIRE_FALSE(unformatter::hexDecode(
+        unformatter::UnformatterDynamic<const char>("c0fg"), pairUnfmt));
+    REQUIRE_FALSE(unformatter::hexDecode(
+        unformatter::UnformatterDynamic<const char>("c0 e"), pairUnfmt));
+}
+
+TEST_CASE("base64 encode decode", "[encoding]")
+{
+    REQUIRE(base64("").empty());
+    REQUIRE(base64("f") == "Zg==");
+    REQUIRE(base64("fo") == "Zm8=");
+    REQUIRE(base64("foo") == "Zm9v");
+    REQUIRE(base64("foobar") == "Zm9vYmFy");
+    REQUIRE(base64("\xff\xfe\xfd") == "//79");
+
+    REQUIRE(unbase64("", 0) == "");
+    REQUIRE(unbase64("Zg==", 1) == "f");
+    REQUIRE(unbase64("Zm8=", 2) == "fo");
+    REQUIRE(unbase64("Zm9vYmFy", 6) == "foobar");
+    REQUIRE(unbase64("//79", 3) == "\xff\xfe\xfd");
+    REQUIRE_FALSE(unbase64("Zm8=", 3));
+    REQUIRE_FALSE(unbase64("Zm8", 2));
+    REQUIRE_FALSE(unbase64("Zm-=", 2));
+    REQUIRE_FALSE(unbase64("Z=8=", 2));
+    REQUIRE_FALSE(unbase64("Zm9v\nmFy", 6));
+}
+
+TEST_CASE("encoding vector kernels", "[encoding]")
+{
+    const std::span pattern(PATTERN);
+    for(std::size_t size = 0; size <= pattern.size(); ++size)
+    {
+        const unformatter::UnformatterDynamic<const std::uint8_t> bytesUnfmt(
+            pattern.first(size));
+        std::string hex(unformatter::hexEncodedSize(size), '\0');
+        REQUIRE(unformatter::hexEncode(
+            bytesUnfmt, unformatter::UnformatterDynamic<char>(std::span(hex))));
+        REQUIRE(hex == std::string_view(PATTERN_HEX.data(), hex.size()));
+        std::vector<std::uint8_t> decoded(size);
+        REQUIRE(unformatter::hexDecode(
+            unformatter::UnformatterDynamic<const char>(hex),
+            unformatter::UnformatterDynamic<std::uint8_t>(decoded)));
+        REQUIRE(std::ranges::equal(decoded, pattern.first(size)));
+
+        std::string base64(unformatter::base64EncodedSize(size), '\0');
+        REQUIRE(unformatter::base64Encode(
+            bytesUnfmt,
+            unformatter::UnformatterDynamic<char>(std::span(base64))));
+        const auto fullSize = size / 3 * 4;
+        REQUIRE(std::string_view(base64).substr(0, fullSize) ==
+                std::string_view(PATTERN_BASE64.data(), fullSize));
+        std::ranges::fill(decoded, 0);
+        REQUIRE(unformatter::base64Decode(
+            unformatter::UnformatterDynamic<const char>(base64),
+            unformatter::UnformatterDynamic<std::uint8_t>(decoded)));
+        REQUIRE(std::ranges::equal(decoded, pattern.first(size)));
+    }
+
+    REQUIRE(std::string_view(PATTERN_HEX.data(), 6) == "0db45b");
+    REQUIRE(std::string_view(PATTERN_BASE64.data(), 8) == "DbRbAqlQ");
+    std::array<std::uint8_t, PATTERN.size()> decoded{};
+    const unformatter::UnformatterDynamic<std::uint8_t> decodedUnfmt(decoded);
+    for(const char invalid : {'/', ':', '@', 'G', '`', 'g', '\x80', '\xc1'})
+    {
+        for(std::size_t pos = 0; pos < PATTERN_HEX.size(); ++pos)
+        {
+            auto hex = PATTERN_HEX;
+            hex[pos] = invalid;
+            REQUIRE_FALSE(unformatter::hexDecode(
+                unformatter::UnformatterDynamic<const char>(hex),
+                decodedUnfmt));
+        }
+    }
+    const auto base64Unfmt = *decodedUnfmt.subs(
+        0, PATTERN_BASE64.size() / 4 * 3 - 2);
+    for(const char invalid : {'-', '.', ':', '@', '[', '`', '{', '\x80'})
+    {
+        for(std::size_t pos = 0; pos < PATTERN_BASE64.size() - 2; ++pos)
+        {
+            auto base64 = PATTERN_BASE64;
+            base64[pos] = invalid;
+            REQUIRE_FALSE(unformatter::base64Decode(
+                unformatter::UnformatterDynamic<const char>(base64),
+                base64Unfmt));
+        }
+    }
+}
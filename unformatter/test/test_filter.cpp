@@ -0,0 +1,167 @@
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "unformatter/filter.hpp"
+#include "unformatter/unformatter.hpp"
+
+namespace
+{
+constexpr std::size_t HEADER_SIZE = 40;
+
+using Header = std::array<std::uint8_t, HEADER_SIZE>;
+
+constexpr auto PAYLOAD_LENGTH =
+    unformatter::filterField<4, std::uint16_t, std::endian::big>;
+constexpr auto HOP_LIMIT = unformatter::filterField<7, std::uint8_t>;
+constexpr auto SRC_PREFIX =
+    unformatter::filterField<8, std::uint64_t, std::endian::big>;
+
+constexpr Header makeHeader(const std::uint16_t payloadLength,
+                            const std::uint8_t hopLimit,
+                            const std::uint64_t srcPrefix)
+{
+    Header header{};
+    const auto headerUnfmt = *unformatter::create<HEADER_SIZE>(header);
+    headerUnfmt.subs<4, 2>().write<std::endian::big>(payloadLength);
+    headerUnfmt.subs<7, 1>().write(hopLimit);
+    headerUnfmt.subs<8, 8>().write<std::endian::big>(srcPrefix);
+    return header;
+}
+
+constexpr unformatter::Filter SUSPICIOUS(
+    HOP_LIMIT < 5 && PAYLOAD_LENGTH > 1000 &&
+    (SRC_PREFIX & 0xffffffffffff0000) == 0x20010db80000'0000);
+
+constexpr bool matchesHeader(const Header &header)
+{
+    return SUSPICIOUS.matches(
+        unformatter::UnformatterStatic<const std::uint8_t, HEADER_SIZE>(
+            *unformatter::create<HEADER_SIZE>(header)));
+}
+
+static_assert(matchesHeader(makeHeader(1500, 1, 0x20010db800001234)));
+static_assert(!matchesHeader(makeHeader(1500, 5, 0x20010db800001234)));
+static_assert(!matchesHeader(makeHeader(1000, 1, 0x20010db800001234)));
+static_assert(!matchesHeader(makeHeader(1500, 1, 0x20010db800011234)));
+}
+
+TEST_CASE("filter select", "[filter]")
+{
+    constexpr std::size_t COUNT = 150;
+    std::vector<Header> headers;
+    for(std::size_t idx = 0; idx < COUNT; ++idx)
+    {
+        headers.push_back(makeHeader(
+            static_cast<std::uint16_t>(idx * 10),
+            static_cast<std::uint8_t>(idx % 7),
+            idx % 3 == 0 ? 0x20010db8ffff0000 : 0x20010db800000000));
+    }
+    std::vector<unformatter::UnformatterStatic<const std::uint8_t, HEADER_SIZE>>
+        packets;
+    for(const auto &header : headers)
+    {
+        packets.push_back(*unformatter::create<HEADER_SIZE>(header));
+    }
+
+    std::array<std::uint64_t, 2> shortSelection{};
+    REQUIRE_FALSE(SUSPICIOUS.select(packets, shortSelection));
+
+    std::array<std::uint64_t, 3> selection{};
+    REQUIRE(SUSPICIOUS.select(packets, selection));
+    for(std::size_t idx = 0; idx < COUNT; ++idx)
+    {
+        const bool expected = idx % 7 < 5 && idx * 10 > 1000 && idx % 3 != 0;
+        REQUIRE(((selection[idx / 64] >> (idx % 64)) & 1) == expected);
+    }
+    REQUIRE(selection[2] >> (COUNT % 64) == 0);
+
+    const unformatter::Filter notLast(!(HOP_LIMIT >= 5 || HOP_LIMIT == 0));
+    REQUIRE(notLast.select(packets, selection));
+    REQUIRE((selection[0] & 0x7f) == 0x1e);
+}
+
+TEST_CASE("filter dynamic packets", "[filter]")
+{
+    const auto full = makeHeader(2000, 2, 0x20010db800000000);
+    const std::vector<unformatter::UnformatterDynamic<const std::uint8_t>>
+        packets{unformatter::UnformatterDynamic<const std::uint8_t>(full),
+                *unformatter::UnformatterDynamic<const std::uint8_t>(full)
+                     .subs(0, 10),
+                *unformatter::UnformatterDynamic<const std::uint8_t>(full)
+                     .subs(0, 16)};
+    std::array<std::uint64_t, 1> selection{};
+    REQUIRE(SUSPICIOUS.select(packets, selection));
+    REQUIRE(selection[0] == 0b101);
+    const unformatter::Filter shortPackets(
+        !(HOP_LIMIT != 2 || SRC_PREFIX != 0x20010db800000000));
+    REQUIRE(shortPackets.select(packets, selection));
+    REQUIRE(selection[0] == 0b101);
+    const unformatter::Filter tooShort(!(SRC_PREFIX != 0));
+    REQUIRE(tooShort.select(packets, selection));
+    REQUIRE(selection[0] == 0b000);
+    const unformatter::Filter equalZero(SRC_PREFIX == 0);
+    REQUIRE(equalZero.select(packets, selection));
+    REQUIRE(selection[0] == 0b000);
+    const unformatter::Filter hopOnly(!(HOP_LIMIT != 2));
+    REQUIRE(hopOnly.select(packets, selection));
+    REQUIRE(selection[0] == 0b111);
+}
+
+namespace
+{
+template<typename V>
+void checkCompareColumns()
+{
+    std::array<V, 64> values{};
+    for(std::size_t idx = 0; idx < values.size(); ++idx)
+    {
+        values[idx] = static_cast<V>(
+            idx % 4 == 0 ? 5
+                         : (idx * 0x9e3779b97f4a7c15) >>
+                               (64 - 8 * sizeof(V)));
+    }
+    std::vector<unformatter::UnformatterStatic<const V, 1>> packets;
+    for(const auto &value : values)
+    {
+        packets.push_back(*unformatter::create<1>(std::span(&value, 1)));
+    }
+    constexpr auto FIELD = unformatter::filterField<0, V>;
+    const auto check = [&](const auto &filter, const auto compare) {
+        std::array<std::uint64_t, 1> selection{};
+        REQUIRE(unformatter::Filter(filter).select(packets, selection));
+        for(std::size_t idx = 0; idx < values.size(); ++idx)
+        {
+            REQUIRE(((selection[0] >> idx) & 1) == compare(values[idx]));
+        }
+    };
+    for(const auto constant : {V{5}, std::numeric_limits<V>::min(),
+                               std::numeric_limits<V>::max(), values[3]})
+    {
+        check(FIELD == constant, [&](const V val) { return val == constant; });
+        check(FIELD != constant, [&](const V val) { return val != constant; });
+        check(FIELD < constant, [&](const V val) { return val < constant; });
+        check(FIELD <= constant, [&](const V val) { return val <= constant; });
+        check(FIELD > constant, [&](const V val) { return val > constant; });
+        check(FIELD >= constant, [&](const V val) { return val >= constant; });
+    }
+}
+}
+
+TEST_CASE("filter compare widths", "[filter]")
+{
+    checkCompareColumns<std::uint8_t>();
+    checkCompareColumns<std::int8_t>();
+    checkCompareColumns<std::uint16_t>();
+    checkCompareColumns<std::int16_t>();
+    checkCompareColumns<std::uint32_t>();
+    checkCompareColumns<std::int32_t>();
+    checkCompareColumns<std::uint64_t>();
+    checkCompareColumns<std::int64_t>();
+}
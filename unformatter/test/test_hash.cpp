@@ -0,0 +1,79 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "unformatter/bit_unformatter.hpp"
+#include "unformatter/hash.hpp"
+#include "unformatter/unformatter.hpp"
+
+namespace
+{
+constexpr bool hashStable()
+{
+    const auto left = std::to_array<std::uint8_t>({1, 2, 3, 4, 5, 6, 7, 8, 9});
+    const auto right =
+        std::to_array<std::uint8_t>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+    const unformatter::Hash hash;
+    return hash(*unformatter::create<left.size()>(left)) ==
+               hash(unformatter::create<right.size()>(right)->subs<1>()) &&
+           hash(*unformatter::create<left.size()>(left)) !=
+               hash(unformatter::create<right.size()>(right)->subs<0, 9>());
+}
+static_assert(hashStable());
+}
+
+TEST_CASE("hash unformatter", "[hash]")
+{
+    constexpr std::size_t ADDRESS_SIZE = 16;
+    constexpr std::size_t COUNT = 64;
+    std::array<std::byte, ADDRESS_SIZE * COUNT> buf{};
+    for(std::size_t idx = 0; idx < COUNT; ++idx)
+    {
+        buf[idx * ADDRESS_SIZE] = std::byte{0x20};
+        buf[idx * ADDRESS_SIZE + 15] = static_cast<std::byte>(idx);
+    }
+    using Address = unformatter::UnformatterDynamic<const std::byte>;
+    const Address bufUnfmt(buf);
+    std::unordered_map<Address, std::size_t> flows;
+    std::set<std::size_t> hashes;
+    for(std::size_t idx = 0; idx < COUNT; ++idx)
+    {
+        const auto address = *bufUnfmt.subs(idx * ADDRESS_SIZE, ADDRESS_SIZE);
+        flows[address] = idx;
+        hashes.insert(std::hash<Address>{}(address));
+    }
+    REQUIRE(flows.size() == COUNT);
+    REQUIRE(hashes.size() == COUNT);
+
+    std::array<std::byte, ADDRESS_SIZE> key{};
+    key[0] = std::byte{0x20};
+    key[15] = std::byte{42};
+    const auto found = flows.find(Address(key));
+    REQUIRE(found != flows.end());
+    REQUIRE(found->second == 42);
+
+    std::unordered_set<Address, unformatter::Hash, std::equal_to<>> keys{
+        Address(key)};
+    REQUIRE(keys.contains(Address(key)));
+    REQUIRE(unformatter::Hash{}(*unformatter::create<ADDRESS_SIZE>(key)) ==
+            unformatter::Hash{}(Address(key)));
+}
+
+TEST_CASE("hash bit unformatter", "[hash]")
+{
+    const auto data =
+        std::to_array<std::uint8_t>({0b10110010, 0b01011001, 0b10000000});
+    const auto dataUnfmt = unformatter::createBit(data);
+    using Bits = unformatter::BitUnformatterDynamic<unformatter::ConstBit>;
+    const std::hash<Bits> hash;
+    REQUIRE(hash(*dataUnfmt.subs(0, 7)) == hash(*dataUnfmt.subs(9, 7)));
+    REQUIRE(hash(*dataUnfmt.subs(0, 7)) != hash(*dataUnfmt.subs(0, 8)));
+    REQUIRE(unformatter::Hash{}(dataUnfmt.subs<0, 3>()) ==
+            hash(*dataUnfmt.subs(9, 3)));
+}
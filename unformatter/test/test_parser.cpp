@@ -0,0 +1,211 @@
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <numeric>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "unformatter/parser.hpp"
+
+namespace
+{
+std::atomic<std::size_t> globalAllocations{0};
+}
+
+// Counts allocations from the global heap, the parser with an allocator
+// shouldn't make any.
+void *operator new(const std::size_t size)
+{
+    globalAllocations.fetch_add(1, std::memory_order_relaxed);
+    if(auto *const ptr = std::malloc(size == 0 ? 1 : size))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+void *operator new(const std::size_t size, const std::nothrow_t &) noexcept
+{
+    globalAllocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size == 0 ? 1 : size);
+}
+void operator delete(void *const ptr) noexcept
+{
+    std::free(ptr);
+}
+void operator delete(void *const ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace
+{
+struct Message
+{
+    std::uint16_t kind;
+    std::vector<std::byte> payload;
+};
+
+// Kind and payload size as big endian 16 bit values, then the payload.
+unformatter::Parser<Message> parseMessage()
+{
+    const auto header = co_await unformatter::need(4);
+    Message message{};
+    message.kind = *header.subs(0, 2)->read<std::uint16_t, std::endian::big>();
+    const auto size =
+        *header.subs(2, 2)->read<std::uint16_t, std::endian::big>();
+    const auto payload = co_await unformatter::need(size);
+    message.payload.assign(payload.begin(), payload.end());
+    co_return message;
+}
+
+template<typename T>
+struct CountingAllocator
+{
+    using value_type = T;
+
+    explicit CountingAllocator(std::size_t &allocated) : allocated(&allocated)
+    {
+    }
+    template<typename U>
+    CountingAllocator(const CountingAllocator<U> &other)
+        : allocated(other.allocated)
+    {
+    }
+
+    T *allocate(const std::size_t count)
+    {
+        *allocated += count * sizeof(T);
+        return static_cast<T *>(std::malloc(count * sizeof(T)));
+    }
+    void deallocate(T *const ptr, const std::size_t count)
+    {
+        *allocated -= count * sizeof(T);
+        std::free(ptr);
+    }
+
+    std::size_t *allocated;
+};
+
+// GCC pairs the frame deallocation with the allocator_arg operator new and
+// reports a mismatch that doesn't exist.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+unformatter::Parser<std::uint32_t> parseSum(std::allocator_arg_t,
+                                            const CountingAllocator<int> &,
+                                            const std::size_t count)
+{
+    std::uint32_t sum = 0;
+    for(std::size_t idx = 0; idx < count; ++idx)
+    {
+        sum += *(co_await unformatter::need(1)).read<std::uint8_t>();
+    }
+    co_return sum;
+}
+
+unformatter::Parser<std::uint32_t> parseWord(std::allocator_arg_t,
+                                             const CountingAllocator<int> &)
+{
+    co_return *(co_await unformatter::need(4))
+                   .read<std::uint32_t, std::endian::big>();
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+constexpr auto MESSAGE = std::to_array<std::byte>(
+    {std::byte{0x00}, std::byte{0x07}, std::byte{0x00}, std::byte{0x03},
+     std::byte{0xaa}, std::byte{0xbb}, std::byte{0xcc}, std::byte{0xff}});
+}
+
+TEST_CASE("parser single chunk", "[parser]")
+{
+    auto parser = parseMessage();
+    REQUIRE_FALSE(parser.done());
+    REQUIRE(parser.feed(MESSAGE) == MESSAGE.size() - 1);
+    REQUIRE(parser.done());
+    REQUIRE(parser.result());
+    REQUIRE(parser.result()->kind == 7);
+    REQUIRE(parser.result()->payload ==
+            std::vector<std::byte>(MESSAGE.begin() + 4, MESSAGE.end() - 1));
+    REQUIRE(parser.feed(MESSAGE) == 0);
+}
+
+TEST_CASE("parser split chunks", "[parser]")
+{
+    for(std::size_t chunkSize = 1; chunkSize < MESSAGE.size(); ++chunkSize)
+    {
+        auto parser = parseMessage();
+        std::size_t consumed = 0;
+        for(std::size_t offset = 0; !parser.done(); offset += chunkSize)
+        {
+            REQUIRE_FALSE(parser.result());
+            consumed += parser.feed(std::span(MESSAGE).subspan(
+                offset, std::min(chunkSize, MESSAGE.size() - offset)));
+        }
+        REQUIRE(consumed == MESSAGE.size() - 1);
+        REQUIRE(parser.result()->kind == 7);
+        REQUIRE(parser.result()->payload.size() == 3);
+        REQUIRE(parser.result()->payload[2] == std::byte{0xcc});
+    }
+}
+
+TEST_CASE("parser moved from", "[parser]")
+{
+    auto parser = parseMessage();
+    auto moved = std::move(parser);
+    REQUIRE(parser.done());
+    REQUIRE(parser.feed(MESSAGE) == 0);
+    REQUIRE_FALSE(parser.result());
+    REQUIRE(moved.feed(MESSAGE) == MESSAGE.size() - 1);
+    REQUIRE(moved.result()->kind == 7);
+}
+
+TEST_CASE("parser allocator", "[parser]")
+{
+    std::size_t allocated = 0;
+    {
+        auto parser = parseSum(std::allocator_arg,
+                               CountingAllocator<int>(allocated), 3);
+        REQUIRE(allocated > 0);
+        const auto data = std::to_array<std::byte>(
+            {std::byte{1}, std::byte{2}, std::byte{3}});
+        REQUIRE(parser.feed(std::span(data).first(2)) == 2);
+        REQUIRE_FALSE(parser.done());
+        REQUIRE(parser.feed(std::span(data).subspan(2)) == 1);
+        REQUIRE(parser.result() == 6);
+    }
+    REQUIRE(allocated == 0);
+}
+
+TEST_CASE("parser allocator carry buffer", "[parser]")
+{
+    std::size_t allocated = 0;
+    {
+        auto parser =
+            parseWord(std::allocator_arg, CountingAllocator<int>(allocated));
+        const auto frameSize = allocated;
+        const auto data = std::to_array<std::byte>(
+            {std::byte{0x12}, std::byte{0x34}, std::byte{0x56}, std::byte{0x78}});
+        const auto before = globalAllocations.load();
+        std::size_t consumed = 0;
+        for(const auto byte : data)
+        {
+            consumed += parser.feed(std::span(&byte, 1));
+        }
+        REQUIRE(globalAllocations.load() == before);
+        REQUIRE(consumed == data.size());
+        REQUIRE(allocated > frameSize);
+        REQUIRE(parser.result() == 0x12345678);
+    }
+    REQUIRE(allocated == 0);
+}
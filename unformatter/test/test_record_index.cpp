@@ -0,0 +1,169 @@
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "unformatter/record_index.hpp"
+#include "unformatter/unformatter.hpp"
+
+namespace
+{
+using Index = unformatter::RecordIndex<std::uint16_t, std::endian::big>;
+using File = Index::File;
+
+// Zero payloads read as zero lengths, so walks from any byte step to the
+// next record.
+std::vector<std::byte> makeRecords(const std::size_t count,
+                                   std::vector<std::size_t> &offsets,
+                                   const bool zeroPayloads = false)
+{
+    std::vector<std::byte> data;
+    std::uint32_t state = zeroPayloads ? 0 : 1;
+    for(std::size_t idx = 0; idx < count; ++idx)
+    {
+        offsets.push_back(data.size());
+        const auto length = static_cast<std::uint16_t>(idx * 37 % 300);
+        data.push_back(static_cast<std::byte>(length >> 8));
+        data.push_back(static_cast<std::byte>(length & 0xff));
+        for(std::size_t pos = 0; pos < length; ++pos)
+        {
+            state = zeroPayloads ? 0 : state * 1103515245 + 12345;
+            data.push_back(static_cast<std::byte>(state >> 16));
+        }
+    }
+    return data;
+}
+
+// Records of random payload lengths up to maxLength filled with random bytes,
+// the length is an L in Endian byte order.
+template<typename L, std::endian Endian>
+std::vector<std::byte> makeRandomRecords(const std::size_t count,
+                                         const std::size_t maxLength,
+                                         std::vector<std::size_t> &offsets)
+{
+    std::vector<std::byte> data;
+    std::mt19937 random(7);
+    std::uniform_int_distribution<std::size_t> lengths(0, maxLength);
+    for(std::size_t idx = 0; idx < count; ++idx)
+    {
+        offsets.push_back(data.size());
+        const auto length = lengths(random);
+        data.resize(data.size() + sizeof(L));
+        REQUIRE(unformatter::UnformatterDynamic<std::byte>(
+                    std::span(data).last(sizeof(L)))
+                    .write<Endian>(static_cast<L>(length)));
+        for(std::size_t pos = 0; pos < length; ++pos)
+        {
+            data.push_back(static_cast<std::byte>(random()));
+        }
+    }
+    return data;
+}
+
+template<typename L, std::endian Endian>
+void checkRandomRecords(const std::size_t maxLength,
+                        const unformatter::RecordIndexOptions &options)
+{
+    using RandomIndex = unformatter::RecordIndex<L, Endian>;
+    std::vector<std::size_t> offsets;
+    const auto data = makeRandomRecords<L, Endian>(3000, maxLength, offsets);
+    unformatter::RecordIndexBuildReport report;
+    const auto index =
+        RandomIndex::build(typename RandomIndex::File(data), options, report);
+    REQUIRE(index);
+    REQUIRE(index->size() == offsets.size());
+    for(std::size_t idx = 0; idx < offsets.size(); ++idx)
+    {
+        REQUIRE(index->offset(idx) == offsets[idx]);
+    }
+    REQUIRE(report.chunks >= 16);
+    REQUIRE(report.adoptedChunks * 4 >= (report.chunks - 1) * 3);
+    REQUIRE(report.serialRecords * 10 < offsets.size());
+}
+}
+
+TEST_CASE("record index build", "[record_index]")
+{
+    std::vector<std::size_t> offsets;
+    const auto data = makeRecords(5000, offsets);
+    const File file(data);
+    for(const std::size_t threads : {1, 3, 8})
+    {
+        const auto index = Index::build(file, {threads, 1});
+        REQUIRE(index);
+        REQUIRE(index->size() == offsets.size());
+        for(std::size_t idx = 0; idx < offsets.size(); ++idx)
+        {
+            REQUIRE(index->offset(idx) == offsets[idx]);
+        }
+    }
+    std::vector<std::size_t> zeroOffsets;
+    const auto zeroData = makeRecords(5000, zeroOffsets, true);
+    const auto zeroIndex = Index::build(File(zeroData), {8, 1});
+    REQUIRE(zeroIndex);
+    REQUIRE(zeroIndex->size() == zeroOffsets.size());
+    REQUIRE(zeroIndex->offset(4321) == zeroOffsets[4321]);
+    REQUIRE(zeroIndex->offset<unformatter::Unchecked>(4999) ==
+            zeroOffsets[4999]);
+
+    const auto index = Index::build(file);
+    REQUIRE(index);
+    const auto payload = index->record(file, 11);
+    REQUIRE(payload);
+    REQUIRE((**payload).size() == 11 * 37 % 300);
+    REQUIRE((**payload).data() == data.data() + offsets[11] + 2);
+    REQUIRE_FALSE(index->record(file, offsets.size()));
+
+    const std::vector<std::byte> empty;
+    const auto emptyIndex = Index::build(File(empty));
+    REQUIRE(emptyIndex);
+    REQUIRE(emptyIndex->size() == 0);
+}
+
+TEST_CASE("record index random payloads", "[record_index]")
+{
+    checkRandomRecords<std::uint16_t, std::endian::big>(
+        1499, {32, std::size_t{1} << 15, 1499});
+    checkRandomRecords<std::uint32_t, std::endian::little>(
+        1499, {32, std::size_t{1} << 15});
+}
+
+TEST_CASE("record index truncated", "[record_index]")
+{
+    std::vector<std::size_t> offsets;
+    auto data = makeRecords(2000, offsets);
+    data.pop_back();
+    REQUIRE_FALSE(Index::build(File(data), {4, 1}));
+    data.resize(offsets.back() + 1);
+    REQUIRE_FALSE(Index::build(File(data), {4, 1}));
+    data.resize(offsets.back());
+    REQUIRE(Index::build(File(data), {4, 1}));
+}
+
+TEST_CASE("record index save load", "[record_index]")
+{
+    std::vector<std::size_t> offsets;
+    const auto data = makeRecords(1000, offsets);
+    const File file(data);
+    const auto index = Index::build(file, {2, 1});
+    REQUIRE(index);
+    auto saved = index->save();
+    const auto loaded = Index::load(File(saved), file);
+    REQUIRE(loaded);
+    REQUIRE(loaded->size() == offsets.size());
+    REQUIRE(loaded->offset(999) == offsets[999]);
+
+    REQUIRE_FALSE(Index::load(File(saved), *file.subs(1)));
+    REQUIRE_FALSE(
+        unformatter::RecordIndex<std::uint16_t, std::endian::little>::load(
+            File(saved), file));
+    REQUIRE_FALSE(unformatter::RecordIndex<std::uint32_t>::load(File(saved),
+                                                                 file));
+    REQUIRE_FALSE(Index::load(*File(saved).subs(0, saved.size() - 1), file));
+    saved[0] = std::byte{0};
+    REQUIRE_FALSE(Index::load(File(saved), file));
+}
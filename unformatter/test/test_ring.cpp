@@ -0,0 +1,79 @@
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "unformatter/ring.hpp"
+
+TEST_CASE("ring region contiguous", "[ring]")
+{
+    std::array<std::uint8_t, 8> ring{};
+    REQUIRE_FALSE(unformatter::RingRegion<std::uint8_t>::create(
+        std::span(ring).first(6), 0, 2));
+    REQUIRE_FALSE(unformatter::RingRegion<std::uint8_t>::create(
+        ring, 0, ring.size() + 1));
+    const auto region =
+        unformatter::RingRegion<std::uint8_t>::create(ring, 10, 4);
+    REQUIRE(region);
+    REQUIRE_FALSE(region->isWrapped());
+    const auto regionUnfmt = region->contiguous();
+    REQUIRE(regionUnfmt);
+    REQUIRE((**regionUnfmt).data() == ring.data() + 2);
+    REQUIRE(region->write<std::endian::big>(std::uint32_t{0x01020304}));
+    REQUIRE(ring == std::to_array<std::uint8_t>({0, 0, 1, 2, 3, 4, 0, 0}));
+}
+
+TEST_CASE("ring region wrapped", "[ring]")
+{
+    std::array<std::uint8_t, 8> ring{};
+    const auto region =
+        unformatter::RingRegion<std::uint8_t>::create(ring, 5, 8);
+    REQUIRE(region);
+    REQUIRE(region->isWrapped());
+    REQUIRE_FALSE(region->contiguous());
+    REQUIRE(region->subs(1, 2)->contiguous());
+    REQUIRE(region->subs(3)->contiguous());
+    REQUIRE_FALSE(region->subs(2, 2)->contiguous());
+    REQUIRE_FALSE(region->subs(9));
+    REQUIRE(region->subs(1, 4)->write<std::endian::big>(
+        std::uint32_t{0x01020304}));
+    REQUIRE(ring == std::to_array<std::uint8_t>({3, 4, 0, 0, 0, 0, 1, 2}));
+    REQUIRE(region->subs(1, 4)->read<std::uint32_t, std::endian::little>() ==
+            0x04030201);
+    REQUIRE_FALSE(region->read<std::uint32_t>());
+
+    const auto values = std::to_array<std::uint16_t>({0x1122, 0x3344, 0x5566,
+                                                      0x7788});
+    REQUIRE(region->writeCollection<std::endian::big>(
+        unformatter::UnformatterDynamic<const std::uint16_t>(values)));
+    REQUIRE(ring == std::to_array<std::uint8_t>(
+                        {0x44, 0x55, 0x66, 0x77, 0x88, 0x11, 0x22, 0x33}));
+    std::array<std::uint16_t, 4> readValues{};
+    REQUIRE(region->readCollection<std::endian::big>(
+        *unformatter::create<readValues.size()>(readValues)));
+    REQUIRE(readValues == values);
+    REQUIRE_FALSE(region->subs(1)->readCollection(
+        *unformatter::create<readValues.size()>(readValues)));
+}
+
+#if defined(__linux__)
+TEST_CASE("mirrored ring", "[ring]")
+{
+    constexpr std::size_t SIZE = std::size_t{1} << 16;
+    REQUIRE_FALSE(unformatter::MirroredRing::create(SIZE + 1));
+    auto maybeRing = unformatter::MirroredRing::create(SIZE);
+    REQUIRE(maybeRing);
+    const auto ring = std::move(*maybeRing);
+    REQUIRE(ring.size() == SIZE);
+    const auto regionUnfmt = ring.region(3 * SIZE - 2, 4);
+    REQUIRE(regionUnfmt);
+    REQUIRE(regionUnfmt->write<std::endian::big>(std::uint32_t{0x01020304}));
+    REQUIRE(ring.ring()[SIZE - 1] == std::byte{0x02});
+    REQUIRE(ring.ring()[0] == std::byte{0x03});
+    REQUIRE(ring.ring()[1] == std::byte{0x04});
+    REQUIRE_FALSE(ring.region(0, SIZE + 1));
+}
+#endif
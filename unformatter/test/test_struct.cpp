@@ -0,0 +1,102 @@
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "unformatter/struct.hpp"
+#include "unformatter/unformatter.hpp"
+
+namespace
+{
+struct IPv6Header
+{
+    std::uint32_t versionClassLabel;
+    std::uint16_t payloadLength;
+    std::uint8_t nextHeader;
+    std::uint8_t hopLimit;
+    std::array<std::uint16_t, 8> src;
+    std::byte dst[16];
+
+    constexpr bool operator==(const IPv6Header &) const = default;
+};
+
+using IPv6HeaderLayout = unformatter::StructLayout<
+    IPv6Header,
+    unformatter::StructField<&IPv6Header::versionClassLabel, 0,
+                             std::endian::big>,
+    unformatter::StructField<&IPv6Header::payloadLength, 4, std::endian::big>,
+    unformatter::StructField<&IPv6Header::nextHeader, 6>,
+    unformatter::StructField<&IPv6Header::hopLimit, 7>,
+    unformatter::StructField<&IPv6Header::src, 8, std::endian::big>,
+    unformatter::StructField<&IPv6Header::dst, 24>>;
+
+// Wire fields are packed, the struct has padding after kind.
+struct Record
+{
+    std::uint8_t kind;
+    std::uint32_t value;
+    std::uint16_t tag;
+};
+
+using RecordLayout = unformatter::StructLayout<
+    Record, unformatter::StructField<&Record::kind, 0>,
+    unformatter::StructField<&Record::value, 1, std::endian::little>,
+    unformatter::StructField<&Record::tag, 6, std::endian::big>>;
+
+constexpr IPv6Header HEADER{
+    .versionClassLabel = 0x60000000,
+    .payloadLength = 0x10,
+    .nextHeader = 0x06,
+    .hopLimit = 0x40,
+    .src = {0x2001, 0x0db8, 0, 0, 0, 0, 0, 1},
+    .dst = {std::byte{0xfe}, std::byte{0x80}},
+};
+
+constexpr auto encodeHeader()
+{
+    std::array<std::byte, IPv6HeaderLayout::size> buf{};
+    unformatter::writeStruct<IPv6HeaderLayout>(
+        *unformatter::create<buf.size()>(buf), HEADER);
+    return buf;
+}
+
+static_assert(IPv6HeaderLayout::size == 40);
+static_assert(IPv6HeaderLayout::covering);
+static_assert(RecordLayout::size == 8);
+static_assert(!RecordLayout::covering);
+static_assert(encodeHeader()[0] == std::byte{0x60});
+static_assert(encodeHeader()[9] == std::byte{0x01});
+static_assert(unformatter::readStruct<IPv6HeaderLayout>(
+                  *unformatter::create<40>(encodeHeader())) == HEADER);
+}
+
+TEST_CASE("struct read", "[struct]")
+{
+    const auto buf = encodeHeader();
+    const auto header = unformatter::readStruct<IPv6HeaderLayout>(
+        *unformatter::create<buf.size()>(buf));
+    REQUIRE(header == HEADER);
+    const auto bufUnfmt = unformatter::UnformatterDynamic<const std::byte>(buf);
+    REQUIRE(unformatter::readStruct<IPv6HeaderLayout>(bufUnfmt) == HEADER);
+    REQUIRE_FALSE(
+        unformatter::readStruct<IPv6HeaderLayout>(*bufUnfmt.subs(0, 39)));
+}
+
+TEST_CASE("struct write packed", "[struct]")
+{
+    auto buf = std::to_array<std::uint8_t>({0, 0, 0, 0, 0, 0xaa, 0, 0});
+    const auto bufUnfmt = unformatter::UnformatterDynamic<std::uint8_t>(buf);
+    REQUIRE(unformatter::writeStruct<RecordLayout>(
+        bufUnfmt, Record{.kind = 1, .value = 0x04030201, .tag = 0x0506}));
+    REQUIRE(buf == std::to_array<std::uint8_t>(
+                       {0x01, 0x01, 0x02, 0x03, 0x04, 0xaa, 0x05, 0x06}));
+    const auto record = unformatter::readStruct<RecordLayout>(
+        *unformatter::create<buf.size()>(buf));
+    REQUIRE(record.kind == 1);
+    REQUIRE(record.value == 0x04030201);
+    REQUIRE(record.tag == 0x0506);
+    REQUIRE_FALSE(unformatter::writeStruct<RecordLayout>(*bufUnfmt.subs(1),
+                                                         Record{}));
+}
@@ -1,8 +1,17 @@
 #include <algorithm>
 #include <array>
 #include <bit>
+#include <compare>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
 
 #include <catch2/catch_test_macros.hpp>
 
@@ -189,3 +198,471 @@ TEST_CASE("unformatter read collection", "[unformatter]")
         REQUIRE(data == std::to_array<Value>({0xb289, 0xc132, 0x71de}));
     }
 }
+
+namespace
+{
+constexpr std::size_t ENCODED_SIZE = 12;
+
+constexpr auto encodeHeader()
+{
+    std::array<std::byte, ENCODED_SIZE> buf{};
+    const auto bufUnfmt = *unformatter::create<ENCODED_SIZE>(buf);
+    const auto [controlUnfmt, addressUnfmt] = bufUnfmt.split<4>();
+    controlUnfmt.subs<0, 2>().write<std::endian::big, std::uint16_t>(0x1234);
+    controlUnfmt.subs<2, 1>().write<std::endian::big, std::uint8_t>(17);
+    controlUnfmt.subs<3, 1>().write<std::endian::big, std::uint8_t>(64);
+    const auto groups =
+        std::to_array<std::uint16_t>({0x2001, 0x0db8, 0x85a3, 0x0001});
+    addressUnfmt.writeCollection<std::endian::big>(
+        *unformatter::create<groups.size()>(groups));
+    return buf;
+}
+
+constexpr auto ENCODED = std::to_array<std::byte>({
+    std::byte{0x12},
+    std::byte{0x34},
+    std::byte{17},
+    std::byte{64},
+    std::byte{0x20},
+    std::byte{0x01},
+    std::byte{0x0d},
+    std::byte{0xb8},
+    std::byte{0x85},
+    std::byte{0xa3},
+    std::byte{0x00},
+    std::byte{0x01},
+});
+
+static_assert(encodeHeader() == ENCODED);
+
+constexpr auto decodeHeader()
+{
+    const auto bufUnfmt = *unformatter::create<ENCODED_SIZE>(ENCODED);
+    std::array<std::uint16_t, 4> groups{};
+    bufUnfmt.subs<4>().readCollection<std::endian::big>(
+        *unformatter::create<groups.size()>(groups));
+    return std::tuple{
+        bufUnfmt.subs<0, 2>().read<std::uint16_t, std::endian::big>(),
+        bufUnfmt.subs<0, 2>().read<std::uint16_t, std::endian::little>(),
+        groups};
+}
+
+static_assert(decodeHeader() ==
+              std::tuple{std::uint16_t{0x1234}, std::uint16_t{0x3412},
+                         std::to_array<std::uint16_t>(
+                             {0x2001, 0x0db8, 0x85a3, 0x0001})});
+
+constexpr auto ENCODED_COPY = encodeHeader();
+static_assert(unformatter::create<ENCODED_SIZE>(ENCODED)->subs<0, 4>() ==
+              unformatter::create<ENCODED_SIZE>(ENCODED_COPY)->subs<0, 4>());
+static_assert(!(unformatter::UnformatterDynamic<const std::byte>(ENCODED) ==
+                unformatter::UnformatterDynamic<const std::byte>(
+                    std::span(ENCODED).subspan(1))));
+
+static_assert(
+    unformatter::create<7>("a423def")->subs<1, 3>().readString<unsigned int>() ==
+    423);
+static_assert(unformatter::create<4>("-128")->readString<std::int8_t>() ==
+              -128);
+static_assert(!unformatter::create<3>("300")->readString<std::uint8_t>());
+static_assert(!unformatter::create<2>("-1")->readString<unsigned int>());
+static_assert(unformatter::create<2>("fF")->readString<int>(16) == 0xff);
+
+static_assert(sizeof(unformatter::UnformatterStatic<std::byte, 4>) ==
+              sizeof(std::byte *));
+static_assert(sizeof(unformatter::UnformatterRanged<std::byte, 2, 4>) ==
+              sizeof(std::span<std::byte>));
+static_assert(
+    std::is_same_v<
+        decltype(unformatter::create<ENCODED_SIZE>(ENCODED)->subs<2, 4>()),
+        unformatter::UnformatterStatic<const std::byte, 4>>);
+}
+
+namespace
+{
+struct AlignedStorage
+{
+    std::uint32_t head;
+    std::array<std::uint32_t, 8> words;
+};
+alignas(64) constinit AlignedStorage alignedStorage{};
+
+// words is at offset 4 of a 64 byte aligned object, so only the alignment of
+// its elements is known in constant evaluation.
+static_assert(
+    !unformatter::createAligned<64, 8>(alignedStorage.words).has_value());
+static_assert(
+    unformatter::createAligned<4, 8>(alignedStorage.words).has_value());
+}
+
+TEST_CASE("unformatter aligned", "[unformatter]")
+{
+    constexpr std::size_t ALIGNMENT = 16;
+    constexpr std::size_t SIZE = 32;
+    alignas(ALIGNMENT) std::array<std::byte, SIZE> buf{};
+    REQUIRE_FALSE(unformatter::createAligned<ALIGNMENT, SIZE - 1>(
+        std::span(buf).subspan(1)));
+    const auto maybeBufUnfmt = unformatter::createAligned<ALIGNMENT, SIZE>(buf);
+    REQUIRE(maybeBufUnfmt);
+    const auto bufUnfmt = *maybeBufUnfmt;
+    STATIC_REQUIRE(std::is_same_v<
+                   decltype(bufUnfmt),
+                   const unformatter::UnformatterStatic<std::byte, SIZE,
+                                                        ALIGNMENT>>);
+    const auto valueUnfmt = bufUnfmt.subs<8, 4>();
+    STATIC_REQUIRE(
+        std::is_same_v<decltype(valueUnfmt),
+                       const unformatter::UnformatterStatic<std::byte, 4, 8>>);
+    STATIC_REQUIRE(std::is_same_v<
+                   decltype(bufUnfmt.subs<ALIGNMENT>()),
+                   unformatter::UnformatterStatic<std::byte, SIZE - ALIGNMENT,
+                                                  ALIGNMENT>>);
+    STATIC_REQUIRE(
+        std::is_same_v<decltype(bufUnfmt.subs<6, 2>()),
+                       unformatter::UnformatterStatic<std::byte, 2, 2>>);
+    valueUnfmt.write<std::endian::big, std::uint32_t>(0x01020304);
+    REQUIRE(valueUnfmt.read<std::uint32_t, std::endian::big>() == 0x01020304);
+    const unformatter::UnformatterStatic<std::byte, 4> unalignedUnfmt =
+        valueUnfmt;
+    REQUIRE(unalignedUnfmt.read<std::uint32_t, std::endian::little>() ==
+            0x04030201);
+    std::array<std::uint32_t, 4> values{};
+    bufUnfmt.subs<0, 16>().readCollection(
+        *unformatter::create<values.size()>(values));
+    REQUIRE(values[2] == std::bit_cast<std::uint32_t>(
+                             std::to_array<std::byte>({std::byte{1},
+                                                       std::byte{2},
+                                                       std::byte{3},
+                                                       std::byte{4}})));
+}
+
+namespace
+{
+template<typename U, typename V>
+concept HasAtomicLoad =
+    requires(const U &unfmt) { unfmt.template atomicLoad<V>(); };
+
+static_assert(HasAtomicLoad<unformatter::UnformatterStatic<std::byte, 4, 4>,
+                            std::uint32_t>);
+static_assert(!HasAtomicLoad<unformatter::UnformatterStatic<std::byte, 4, 2>,
+                             std::uint32_t>);
+static_assert(!HasAtomicLoad<unformatter::UnformatterStatic<std::byte, 8, 8>,
+                             std::uint32_t>);
+static_assert(
+    !HasAtomicLoad<unformatter::UnformatterStatic<const std::byte, 4, 4>,
+                   std::uint32_t>);
+static_assert(
+    HasAtomicLoad<unformatter::UnformatterStatic<std::uint32_t, 1>,
+                  std::uint32_t>);
+}
+
+TEST_CASE("unformatter atomic", "[unformatter]")
+{
+    constexpr std::size_t ALIGNMENT = 8;
+    constexpr std::size_t SIZE = 16;
+    constexpr std::uint64_t INCREMENTS = 10000;
+    alignas(ALIGNMENT) std::array<std::byte, SIZE> buf{};
+    const auto bufUnfmt = *unformatter::createAligned<ALIGNMENT, SIZE>(buf);
+    const auto counterUnfmt = bufUnfmt.subs<0, 8>();
+    const auto flagUnfmt = bufUnfmt.subs<12, 4>();
+
+    counterUnfmt.atomicStore<std::uint64_t>(5, std::memory_order_relaxed);
+    REQUIRE(counterUnfmt.atomicLoad<std::uint64_t>() == 5);
+    REQUIRE(counterUnfmt.fetchAdd<std::uint64_t>(2) == 5);
+    std::uint32_t expected = 1;
+    REQUIRE_FALSE(flagUnfmt.compareExchange<std::uint32_t>(expected, 2));
+    REQUIRE(expected == 0);
+    REQUIRE(flagUnfmt.compareExchange<std::uint32_t>(
+        expected, 3, std::memory_order_acq_rel, std::memory_order_acquire));
+    REQUIRE(flagUnfmt.read<std::uint32_t>() == 3);
+
+    const auto increment = [&counterUnfmt] {
+        for(std::uint64_t idx = 0; idx < INCREMENTS; ++idx)
+        {
+            counterUnfmt.fetchAdd<std::uint64_t>(1, std::memory_order_relaxed);
+        }
+    };
+    std::thread first(increment);
+    std::thread second(increment);
+    first.join();
+    second.join();
+    REQUIRE(counterUnfmt.atomicLoad<std::uint64_t>(
+                std::memory_order_acquire) == 7 + 2 * INCREMENTS);
+}
+
+TEST_CASE("unformatter compare", "[unformatter]")
+{
+    auto buf = std::to_array<std::uint8_t>(
+        {0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x01, 0x20, 0x01, 0x0d,
+         0xb8, 0x00, 0x00, 0x00, 0x02, 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00,
+         0x00, 0x01});
+    const auto bufUnfmt = *unformatter::create<buf.size()>(buf);
+    const auto first = bufUnfmt.subs<0, 8>();
+    const auto second = bufUnfmt.subs<8, 8>();
+    const auto third = bufUnfmt.subs<16, 8>();
+    REQUIRE(first == third);
+    REQUIRE_FALSE(first == second);
+    REQUIRE((first <=> second) == std::strong_ordering::less);
+    REQUIRE((second <=> third) == std::strong_ordering::greater);
+    REQUIRE((first <=> third) == std::strong_ordering::equal);
+
+    const unformatter::UnformatterDynamic<std::uint8_t> dynFirst(first);
+    const auto dynPrefix = *dynFirst.subs(0, 4);
+    REQUIRE(dynFirst == unformatter::UnformatterDynamic<std::uint8_t>(third));
+    REQUIRE_FALSE(dynFirst == dynPrefix);
+    REQUIRE(dynPrefix < dynFirst);
+    REQUIRE(dynFirst > unformatter::UnformatterDynamic<std::uint8_t>(
+                           *bufUnfmt.subs(0, 0)));
+
+    std::array<std::uint32_t, 10> left{};
+    std::array<std::uint32_t, 10> right{};
+    right[9] = 1;
+    const auto leftUnfmt = *unformatter::create<left.size()>(left);
+    const auto rightUnfmt = *unformatter::create<right.size()>(right);
+    REQUIRE_FALSE(leftUnfmt == rightUnfmt);
+    REQUIRE(leftUnfmt < rightUnfmt);
+    right[9] = 0;
+    REQUIRE(leftUnfmt == rightUnfmt);
+
+    std::array<std::uint8_t, 64> wideLeft{};
+    std::array<std::uint8_t, 64> wideRight{};
+    const auto checkWide = [&]<std::size_t Size>() {
+        const auto leftWide = *unformatter::create<Size>(
+            std::span<std::uint8_t, Size>(wideLeft.data(), Size));
+        const auto rightWide = *unformatter::create<Size>(
+            std::span<std::uint8_t, Size>(wideRight.data(), Size));
+        for(std::size_t idx = 0; idx < Size; ++idx)
+        {
+            wideRight[idx] = 0x80;
+            REQUIRE_FALSE(leftWide == rightWide);
+            wideRight[idx] = 0;
+        }
+        REQUIRE(leftWide == rightWide);
+    };
+    checkWide.operator()<16>();
+    checkWide.operator()<24>();
+    checkWide.operator()<40>();
+    checkWide.operator()<64>();
+}
+
+namespace
+{
+constexpr bool compareStatic()
+{
+    const auto buf = std::to_array<std::byte>(
+        {std::byte{1}, std::byte{2}, std::byte{1}, std::byte{3}});
+    const auto bufUnfmt = *unformatter::create<buf.size()>(buf);
+    return bufUnfmt.subs<0, 1>() == bufUnfmt.subs<2, 1>() &&
+           bufUnfmt.subs<0, 2>() < bufUnfmt.subs<2, 2>();
+}
+static_assert(compareStatic());
+}
+
+TEST_CASE("unformatter streaming collection", "[unformatter]")
+{
+    constexpr std::size_t SIZE = (std::size_t{1} << 21) + 37;
+    std::vector<std::uint8_t> src(SIZE + 3);
+    for(std::size_t idx = 0; idx < src.size(); ++idx)
+    {
+        src[idx] = static_cast<std::uint8_t>(idx * 7 + idx / 251);
+    }
+    std::vector<std::uint8_t> dst(SIZE + 5);
+    const unformatter::UnformatterDynamic<const std::uint8_t> srcUnfmt(src);
+    const unformatter::UnformatterDynamic<std::uint8_t> dstUnfmt(dst);
+
+    REQUIRE(dstUnfmt.subs(5)->writeCollection(*srcUnfmt.subs(3)));
+    REQUIRE(std::ranges::equal(std::span(dst).subspan(5),
+                               std::span(src).subspan(3)));
+
+    std::ranges::fill(dst, 0);
+    REQUIRE(dstUnfmt.subs(1, 100)->writeCollectionStreaming(
+        *srcUnfmt.subs(2, 100)));
+    REQUIRE(std::ranges::equal(std::span(dst).subspan(1, 100),
+                               std::span(src).subspan(2, 100)));
+    REQUIRE(dst[0] == 0);
+    REQUIRE(dst[101] == 0);
+    REQUIRE_FALSE(dstUnfmt.writeCollectionStreaming(srcUnfmt));
+
+    std::vector<std::uint16_t> words(SIZE / 2);
+    const unformatter::UnformatterDynamic<std::uint16_t> wordsUnfmt(words);
+    REQUIRE(srcUnfmt.subs(1, words.size() * 2)
+                ->readCollectionStreaming(wordsUnfmt));
+    REQUIRE(std::memcmp(words.data(), src.data() + 1, words.size() * 2) == 0);
+    REQUIRE(dstUnfmt.subs(0, 3)->writeCollectionStreaming(
+        *srcUnfmt.subs(0, 3)));
+    REQUIRE(dstUnfmt.subs(0, 0)->writeCollectionStreaming(
+        *srcUnfmt.subs(0, 0)));
+}
+
+TEST_CASE("unformatter overlapping collection", "[unformatter]")
+{
+    constexpr std::size_t SIZE = (std::size_t{1} << 21) + 37;
+    std::vector<std::uint8_t> buf(SIZE + 16);
+    for(std::size_t idx = 0; idx < buf.size(); ++idx)
+    {
+        buf[idx] = static_cast<std::uint8_t>(idx * 7 + idx / 251);
+    }
+    const auto expected = buf;
+    const unformatter::UnformatterDynamic<std::uint8_t> bufUnfmt(buf);
+
+    REQUIRE(bufUnfmt.subs(3, 10)->writeCollection(*bufUnfmt.subs(0, 10)));
+    REQUIRE(std::ranges::equal(std::span(buf).subspan(3, 10),
+                               std::span(expected).first(10)));
+    REQUIRE(bufUnfmt.subs(0, 10)->writeCollection(*bufUnfmt.subs(3, 10)));
+    REQUIRE(std::ranges::equal(std::span(buf).first(3),
+                               std::span(expected).first(3)));
+
+    buf = expected;
+    const auto staticUnfmt = *unformatter::create<16, 16>(
+        std::span<std::uint8_t, 16>(buf.data(), 16));
+    staticUnfmt.subs<4, 12>().readCollection(staticUnfmt.subs<0, 12>());
+    REQUIRE(std::ranges::equal(std::span(buf).first(12),
+                               std::span(expected).subspan(4, 12)));
+
+    buf = expected;
+    REQUIRE(bufUnfmt.subs(9, SIZE)->writeCollection(*bufUnfmt.subs(1, SIZE)));
+    REQUIRE(std::ranges::equal(std::span(buf).subspan(9, SIZE),
+                               std::span(expected).subspan(1, SIZE)));
+    buf = expected;
+    REQUIRE(bufUnfmt.subs(1, SIZE)->writeCollectionStreaming(
+        *bufUnfmt.subs(9, SIZE)));
+    REQUIRE(std::ranges::equal(std::span(buf).subspan(1, SIZE),
+                               std::span(expected).subspan(9, SIZE)));
+}
+
+TEST_CASE("unformatter unchecked", "[unformatter]")
+{
+    std::array<std::uint8_t, 8> data{1, 2, 3, 4, 5, 6, 7, 8};
+    const unformatter::UnformatterDynamic<std::uint8_t> dataUnfmt(data);
+    const auto fieldUnfmt = dataUnfmt.subsUnchecked(2, 4);
+    REQUIRE(fieldUnfmt.size() == 4);
+    REQUIRE(fieldUnfmt.readUnchecked<std::uint32_t, std::endian::big>() ==
+            0x03040506);
+    REQUIRE(dataUnfmt.subsUnchecked<unformatter::Unchecked>(6).size() == 2);
+    dataUnfmt.subsUnchecked<unformatter::Unchecked>(6)
+        .writeUnchecked<std::endian::little, unformatter::Unchecked>(
+            std::uint16_t{0x1234});
+    REQUIRE(data[6] == 0x34);
+    REQUIRE(data[7] == 0x12);
+    REQUIRE(dataUnfmt.subsUnchecked(8).size() == 0);
+
+    const std::array<std::uint16_t, 2> words{0x0102, 0x0304};
+    const unformatter::UnformatterDynamic<const std::uint16_t> wordsUnfmt(
+        words);
+    REQUIRE(wordsUnfmt.readUnchecked<std::uint32_t>() ==
+            std::bit_cast<std::uint32_t>(words));
+}
+
+TEST_CASE("unformatter short integer", "[unformatter]")
+{
+    std::array<std::uint8_t, 10> buf{0xf1, 0x02, 0x03, 0x04, 0x05,
+                                     0x06, 0x07, 0x08, 0x09, 0x0a};
+    const auto bufUnfmt = *unformatter::create<buf.size()>(buf);
+    REQUIRE(bufUnfmt.subs<0, 3>().readInteger<std::uint32_t, std::endian::big>() ==
+            0xf10203);
+    REQUIRE(
+        bufUnfmt.subs<0, 3>().readInteger<std::uint32_t, std::endian::little>() ==
+        0x0302f1);
+    REQUIRE(bufUnfmt.subs<0, 3>().readInteger<std::int32_t, std::endian::big>() ==
+            -0x0efdfd);
+    REQUIRE(bufUnfmt.subs<1, 6>().readInteger<std::uint64_t, std::endian::big>() ==
+            0x020304050607);
+    REQUIRE(
+        bufUnfmt.subs<2, 7>().readInteger<std::uint64_t, std::endian::little>() ==
+        0x09080706050403);
+    REQUIRE(bufUnfmt.subs<0, 1>().readInteger<std::int16_t>() == -0x0f);
+    REQUIRE(bufUnfmt.subs<0, 8>().readInteger<std::uint64_t, std::endian::big>() ==
+            0xf102030405060708);
+
+    bufUnfmt.subs<1, 5>().writeInteger<std::endian::big>(
+        std::uint64_t{0xff1122334455});
+    REQUIRE(buf == std::to_array<std::uint8_t>({0xf1, 0x11, 0x22, 0x33, 0x44,
+                                                0x55, 0x07, 0x08, 0x09, 0x0a}));
+    bufUnfmt.subs<6, 3>().writeInteger<std::endian::little>(std::int32_t{-2});
+    REQUIRE(buf == std::to_array<std::uint8_t>({0xf1, 0x11, 0x22, 0x33, 0x44,
+                                                0x55, 0xfe, 0xff, 0xff, 0x0a}));
+
+    const unformatter::UnformatterDynamic<std::uint8_t> dynUnfmt(buf);
+    for(std::size_t size = 1; size <= sizeof(std::uint64_t); ++size)
+    {
+        const auto fieldUnfmt = *dynUnfmt.subs(1, size);
+        const auto after = buf[size + 1];
+        REQUIRE(fieldUnfmt.writeInteger<std::endian::big>(
+            std::uint64_t{0x0102030405060708}));
+        std::uint64_t big = 0;
+        std::uint64_t little = 0;
+        for(std::size_t idx = 0; idx < size; ++idx)
+        {
+            big = big << 8 | (9 - size + idx);
+            little = little << 8 | (8 - idx);
+        }
+        REQUIRE(fieldUnfmt.readInteger<std::uint64_t, std::endian::big>() ==
+                big);
+        REQUIRE(fieldUnfmt.readInteger<std::uint64_t, std::endian::little>() ==
+                little);
+        REQUIRE(buf[0] == 0xf1);
+        REQUIRE(buf[size + 1] == after);
+    }
+    REQUIRE_FALSE(dynUnfmt.subs(0, 3)->readInteger<std::uint16_t>());
+    REQUIRE_FALSE(dynUnfmt.subs(0, 0)->readInteger<std::uint16_t>());
+    REQUIRE_FALSE(dynUnfmt.subs(0, 9)->writeInteger(std::uint64_t{}));
+
+    STATIC_REQUIRE([] {
+        std::array<std::byte, 4> data{};
+        const auto dataUnfmt = *unformatter::create<data.size()>(data);
+        dataUnfmt.subs<1, 3>().writeInteger<std::endian::big>(-3);
+        return dataUnfmt.subs<1, 3>().readInteger<int, std::endian::big>() ==
+                   -3 &&
+               data[1] == std::byte{0xff} && data[3] == std::byte{0xfd};
+    }());
+}
+
+TEST_CASE("unformatter chunks", "[unformatter]")
+{
+    std::array<std::uint8_t, 11> buf{0x00, 0x01, 0x00, 0x02, 0x00, 0x03,
+                                     0x00, 0x04, 0x00, 0x05, 0xff};
+    const unformatter::UnformatterDynamic<std::uint8_t> bufUnfmt(buf);
+    const auto records = bufUnfmt.chunks<2>(2);
+    STATIC_REQUIRE(std::ranges::random_access_range<decltype(records)>);
+    STATIC_REQUIRE(std::ranges::sized_range<decltype(records)>);
+    STATIC_REQUIRE(std::ranges::borrowed_range<decltype(records)>);
+    STATIC_REQUIRE(std::is_same_v<
+                   std::iterator_traits<std::ranges::iterator_t<
+                       decltype(records)>>::iterator_category,
+                   std::input_iterator_tag>);
+    STATIC_REQUIRE(
+        std::is_same_v<std::ranges::range_value_t<decltype(records)>,
+                       unformatter::UnformatterStatic<std::uint8_t, 2>>);
+    REQUIRE(records.size() == 5);
+    REQUIRE(records.remainder().size() == 1);
+    REQUIRE(records.remainder().read<std::uint8_t>() == 0xff);
+
+    std::vector<std::uint16_t> values;
+    for(const auto record : records)
+    {
+        values.push_back(record.read<std::uint16_t, std::endian::big>());
+    }
+    REQUIRE(values == std::vector<std::uint16_t>{1, 2, 3, 4, 5});
+    REQUIRE(records[3].read<std::uint16_t, std::endian::big>() == 4);
+    REQUIRE(records.back().read<std::uint16_t, std::endian::big>() == 5);
+    REQUIRE(std::ranges::count_if(records, [](const auto record) {
+                return record.template read<std::uint16_t, std::endian::big>() %
+                           2 ==
+                       1;
+            }) == 3);
+
+    std::ranges::for_each(std::views::reverse(records),
+                          [](const auto record) {
+                              record.template write<std::endian::little>(
+                                  std::uint16_t{7});
+                          });
+    REQUIRE(buf == std::to_array<std::uint8_t>({0x07, 0x00, 0x07, 0x00, 0x07,
+                                                0x00, 0x07, 0x00, 0x07, 0x00,
+                                                0xff}));
+
+    const auto staticRecords =
+        (*unformatter::create<buf.size()>(buf)).chunks<4>();
+    REQUIRE(staticRecords.size() == 2);
+    REQUIRE(staticRecords.remainder().size() == 3);
+    REQUIRE(bufUnfmt.subs(0, 1)->chunks<2>().empty());
+}
@@ -1,4 +1,9 @@
 #include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
 
 #include <catch2/catch_test_macros.hpp>
 
@@ -19,6 +24,8 @@ TEST_CASE("util split", "[util]")
     fstUnfmt.writeRepr<0b101>();
     sndUnfmt.writeRepr<0xfd>();
     thrdUnfmt.writeRepr<0b11111111>();
+    STATIC_REQUIRE(sizeof(fstUnfmt) ==
+                   sizeof(std::byte *) + sizeof(std::size_t));
     REQUIRE(val == std::to_array<unsigned char>({
                        0b10100000,
                        0b00000001,
@@ -26,3 +33,42 @@ TEST_CASE("util split", "[util]")
                        0b11111111,
                    }));
 }
+
+TEST_CASE("util split keeps extent", "[util]")
+{
+    std::array<std::byte, 8> buf{};
+    const auto [fstUnfmt, sndUnfmt] =
+        unformatter::util::split<2>(*unformatter::create<buf.size()>(buf));
+    STATIC_REQUIRE(
+        std::is_same_v<std::remove_const_t<decltype(sndUnfmt)>,
+                       unformatter::UnformatterStatic<std::byte, 6>>);
+    STATIC_REQUIRE(sizeof(std::tuple<decltype(fstUnfmt), decltype(sndUnfmt)>) ==
+                   2 * sizeof(std::byte *));
+    sndUnfmt.subs<2, 4>().write<std::endian::big, std::uint32_t>(0x01020304);
+    REQUIRE(buf[6] == std::byte{0x03});
+}
+
+TEST_CASE("util visit split", "[util]")
+{
+    std::array<std::byte, 6> buf{};
+    const auto sum = unformatter::util::visitSplit<1, 2, 4>(
+        *unformatter::create<buf.size()>(buf),
+        [](const auto fstUnfmt, const auto sndUnfmt, const auto thrdUnfmt,
+           const auto frthUnfmt) {
+            fstUnfmt.template write<std::endian::big, std::uint8_t>(0x01);
+            sndUnfmt.template write<std::endian::big, std::uint8_t>(0x02);
+            thrdUnfmt.template write<std::endian::big, std::uint16_t>(0x0304);
+            frthUnfmt.template write<std::endian::big, std::uint16_t>(0x0506);
+            return fstUnfmt.size() + sndUnfmt.size() + thrdUnfmt.size() +
+                   frthUnfmt.size();
+        });
+    REQUIRE(sum == buf.size());
+    REQUIRE(buf == std::to_array<std::byte>({
+                       std::byte{0x01},
+                       std::byte{0x02},
+                       std::byte{0x03},
+                       std::byte{0x04},
+                       std::byte{0x05},
+                       std::byte{0x06},
+                   }));
+}